@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Selba Ward - Benchmark harness
+//
+//  by Hapaxia (https://github.com/Hapaxia)
+//
+//
+//  Times an operation until a minimum duration has passed and reports:
+//    ns/op         nanoseconds per operation
+//    Mvertices/s   millions of vertices generated per second (if the operation generates vertices)
+//    MB/s          megabytes processed per second (if the operation processes bytes)
+//    allocs/op     heap allocations per operation (counted by the replacement operator new)
+//
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SELBAWARD_BENCHMARK_HPP
+#define SELBAWARD_BENCHMARK_HPP
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace benchmark
+{
+
+inline std::atomic<std::size_t> numberOfAllocations{ 0u };
+
+struct Settings
+{
+	std::string filter; // only benchmarks whose names contain this are run
+	double minimumDuration{ 0.25 }; // in seconds
+};
+inline Settings settings;
+
+struct Work // work performed by a single call of an operation
+{
+	std::size_t operations{ 1u };
+	std::size_t vertices{ 0u };
+	std::size_t bytes{ 0u };
+	std::size_t drawCalls{ 0u }; // draw calls submitted to the render target
+};
+
+// a render target that never becomes active so drawing performs only the drawable's CPU-side updates (no OpenGL context is required)
+class NullRenderTarget : public sf::RenderTarget
+{
+public:
+	sf::Vector2u getSize() const override { return { 1920u, 1080u }; }
+	bool setActive(bool) override { return false; }
+};
+
+inline bool isSelected(const std::string& name)
+{
+	return settings.filter.empty() || (name.find(settings.filter) != std::string::npos);
+}
+
+inline void printHeader()
+{
+	std::printf("%-48s %12s %12s %10s %10s %10s\n", "benchmark", "ns/op", "Mvertices/s", "MB/s", "draws/op", "allocs/op");
+}
+
+inline void printResult(const std::string& name, const Work work, const std::size_t numberOfCalls, const double seconds, const std::size_t allocations)
+{
+	const double operations{ static_cast<double>(numberOfCalls) * work.operations };
+	char vertexRate[32]{ "-" };
+	char byteRate[32]{ "-" };
+	char drawCalls[32]{ "-" };
+	if (work.vertices > 0u)
+		std::snprintf(vertexRate, sizeof(vertexRate), "%.2f", static_cast<double>(numberOfCalls) * work.vertices / seconds / 1e6);
+	if (work.bytes > 0u)
+		std::snprintf(byteRate, sizeof(byteRate), "%.1f", static_cast<double>(numberOfCalls) * work.bytes / seconds / (1024.0 * 1024.0));
+	if (work.drawCalls > 0u)
+		std::snprintf(drawCalls, sizeof(drawCalls), "%.1f", static_cast<double>(work.drawCalls) / work.operations);
+	std::printf("%-48s %12.1f %12s %10s %10s %10.2f\n", name.c_str(), seconds * 1e9 / operations, vertexRate, byteRate, drawCalls, allocations / operations);
+	std::fflush(stdout);
+}
+
+template <class Operation>
+void run(const std::string& name, const Work work, Operation&& operation)
+{
+	if (!isSelected(name))
+		return;
+
+	using Clock = std::chrono::steady_clock;
+
+	operation(); // warm-up (also allows containers to reach their working size before allocations are counted)
+
+	const std::size_t allocationsBefore{ numberOfAllocations.load(std::memory_order_relaxed) };
+	const Clock::time_point start{ Clock::now() };
+	std::size_t numberOfCalls{ 0u };
+	std::size_t batchSize{ 1u };
+	double seconds{ 0.0 };
+	while (seconds < settings.minimumDuration)
+	{
+		// the clock is only read between batches so its cost does not affect short operations
+		for (std::size_t i{ 0u }; i < batchSize; ++i)
+			operation();
+		numberOfCalls += batchSize;
+		batchSize *= 2u;
+		seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	}
+	const std::size_t allocations{ numberOfAllocations.load(std::memory_order_relaxed) - allocationsBefore };
+
+	printResult(name, work, numberOfCalls, seconds, allocations);
+}
+
+} // namespace benchmark
+#endif // SELBAWARD_BENCHMARK_HPP
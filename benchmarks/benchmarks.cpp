@@ -0,0 +1,751 @@
+//////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Selba Ward - Benchmarks
+//
+//  by Hapaxia (https://github.com/Hapaxia)
+//
+//
+//  Headless benchmarks of the CPU-side geometry of Selba Ward's drawables.
+//  Drawing is to a render target that is never activated so no window or OpenGL context is required.
+//
+//    Usage:
+//
+//  benchmarks [filter] [--gl] [--duration seconds]
+//
+//  filter                  Only run benchmarks whose names contain this text
+//  --gl                    Also run benchmarks that require an OpenGL context (Tile Map renders into a render texture)
+//  --duration seconds      Minimum time spent on each benchmark (default: 0.25)
+//
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.hpp"
+
+#include <SFML/Graphics.hpp>
+#include <SelbaWard/BitmapFont.hpp>
+#include <SelbaWard/BitmapText.hpp>
+#include <SelbaWard/ConsoleScreen.hpp>
+#include <SelbaWard/NinePatch.hpp>
+#include <SelbaWard/PixelDisplay.hpp>
+#include <SelbaWard/Polygon.hpp>
+#include <SelbaWard/ProgressBar.hpp>
+#include <SelbaWard/Random.hpp>
+#include <SelbaWard/RenderBatcher.hpp>
+#include <SelbaWard/Ring.hpp>
+#include <SelbaWard/Spline.hpp>
+#include <SelbaWard/Sprite3d.hpp>
+#include <SelbaWard/SpriteBatch.hpp>
+#include <SelbaWard/Starfield3d.hpp>
+#include <SelbaWard/TileMap.hpp>
+#include <SelbaWard/VertexSink.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <thread>
+
+// count every heap allocation made by the program
+// the replacements use malloc and free. GCC sees free in the (inlined) delete called on memory from new and warns, although they are a matching pair here
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(const std::size_t size)
+{
+	benchmark::numberOfAllocations.fetch_add(1u, std::memory_order_relaxed);
+	if (void* const pointer{ std::malloc((size > 0u) ? size : 1u) })
+		return pointer;
+	throw std::bad_alloc{};
+}
+void* operator new[](const std::size_t size)
+{
+	return operator new(size);
+}
+void operator delete(void* const pointer) noexcept
+{
+	std::free(pointer);
+}
+void operator delete[](void* const pointer) noexcept
+{
+	std::free(pointer);
+}
+void operator delete(void* const pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+void operator delete[](void* const pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+
+using benchmark::Work;
+
+std::mt19937 randomGenerator{ 1u }; // fixed seed so every run generates the same scenes
+
+float randomValue(const float low, const float high)
+{
+	return std::uniform_real_distribution<float>(low, high)(randomGenerator);
+}
+
+void benchmarkConsoleScreen()
+{
+	const sf::Vector2u mode{ 80u, 45u };
+	const std::size_t numberOfVerticesPerCell{ 12u }; // foreground and background quads
+
+	{
+		sw::ConsoleScreen console(mode);
+		console.setShowCursor(false);
+		for (unsigned int i{ 0u }; i < console.getNumberOfCells(); ++i)
+			console.poke(i, static_cast<unsigned int>(i % 256u));
+		bool alternate{ false };
+		benchmark::run("ConsoleScreen::update (all cells)", Work{ 1u, console.getNumberOfCells() * numberOfVerticesPerCell }, [&]()
+		{
+			alternate = !alternate;
+			console.setSize({ alternate ? 640.f : 641.f, 360.f }); // regenerates every cell
+			console.update();
+		});
+	}
+
+	{
+		sw::ConsoleScreen console(mode);
+		console.setShowCursor(false);
+		const std::string row(mode.x, '#');
+		benchmark::run("ConsoleScreen::update (one row printed)", Work{ 1u, mode.x * numberOfVerticesPerCell }, [&]()
+		{
+			console << sw::ConsoleScreen::Location(0u, 10u) << row;
+			console.update();
+		});
+	}
+
+	for (const bool useRowRingBuffer : { false, true })
+	{
+		sw::ConsoleScreen console(mode);
+		console.setShowCursor(false);
+		console.setUseRowRingBuffer(useRowRingBuffer);
+		console << sw::ConsoleScreen::Location(0u, mode.y - 1u);
+		benchmark::run(std::string("ConsoleScreen::update (scroll") + (useRowRingBuffer ? ", ring buffer)" : ")"), Work{}, [&]()
+		{
+			console << "scrolling line" << sw::ConsoleScreen::CursorCommand::Newline;
+			console.update();
+		});
+	}
+
+	{
+		std::string plainText;
+		std::string ansiText;
+		while (plainText.size() < 65536u)
+		{
+			plainText += "The quick brown fox jumps over the lazy dog. 0123456789\n";
+			ansiText += "\x1B[1;31mThe quick\x1B[0m brown \x1B[38;5;208mfox\x1B[39m jumps over the \x1B[7mlazy\x1B[27m dog.\x1B[K 0123456789\r\n";
+		}
+		sw::ConsoleScreen console(mode);
+		console.setUseRowRingBuffer(true);
+		console.setUpdateAutomatically(false);
+		benchmark::run("ConsoleScreen::write (plain text)", Work{ 1u, 0u, plainText.size() }, [&]() { console.write(plainText); });
+		benchmark::run("ConsoleScreen::write (ANSI escape sequences)", Work{ 1u, 0u, ansiText.size() }, [&]() { console.write(ansiText); });
+	}
+
+	{
+		sw::ConsoleScreen console(mode);
+		console.setUpdateAutomatically(false);
+		const std::size_t numberOfItemsPerProducer{ 10000u };
+		for (const std::size_t numberOfProducers : { 1u, 2u, 4u, 8u, 16u })
+		{
+			benchmark::run("ConsoleScreen::queue (" + std::to_string(numberOfProducers) + ((numberOfProducers == 1u) ? " producer)" : " producers)"), Work{ numberOfProducers * numberOfItemsPerProducer }, [&]()
+			{
+				std::atomic<std::size_t> numberOfProducersFinished{ 0u };
+				std::vector<std::thread> producers;
+				for (std::size_t p{ 0u }; p < numberOfProducers; ++p)
+				{
+					producers.emplace_back([&, p]()
+					{
+						for (std::size_t i{ 0u }; i < numberOfItemsPerProducer; ++i)
+							console.queue(sw::ConsoleScreen::Location(static_cast<unsigned int>(p), 0u), 'x');
+						++numberOfProducersFinished;
+					});
+				}
+				while (numberOfProducersFinished < numberOfProducers)
+					console.processQueue();
+				for (auto& producer : producers)
+					producer.join();
+				console.processQueue();
+			});
+		}
+	}
+}
+
+void benchmarkSpriteBatch()
+{
+	const sf::Texture texture;
+	const std::size_t numberOfSprites{ 10000u };
+	std::vector<sf::Sprite> sprites(numberOfSprites, sf::Sprite(texture, { { 0, 0 }, { 16, 16 } }));
+	for (auto& sprite : sprites)
+	{
+		sprite.setPosition({ randomValue(0.f, 1920.f), randomValue(0.f, 1080.f) });
+		sprite.setRotation(sf::degrees(randomValue(0.f, 360.f)));
+	}
+
+	benchmark::NullRenderTarget target;
+	sw::SpriteBatch batch;
+	batch.setTexture(texture);
+	batch.batchSprites(sprites);
+	benchmark::run("SpriteBatch::priv_updateAll", Work{ 1u, numberOfSprites * 6u }, [&]()
+	{
+		batch.move({ 0.5f, 0.f }); // requires every sprite to be updated
+		target.draw(batch);
+	});
+
+	batch.setOrderFunction([](const sf::Sprite* a, const sf::Sprite* b) { return a->getPosition().y < b->getPosition().y; });
+	benchmark::run("SpriteBatch::priv_updateAll (ordered)", Work{ 1u, numberOfSprites * 6u }, [&]()
+	{
+		batch.move({ 0.5f, 0.f });
+		target.draw(batch);
+	});
+
+	// manual order: a thousand sprites drawn first (in reverse), with every sprite moved and then with only one sprite moved
+	std::vector<std::size_t> orderIndices(1000u);
+	for (std::size_t i{ 0u }; i < orderIndices.size(); ++i)
+		orderIndices[i] = numberOfSprites - 1u - i * 10u;
+	batch.setOrder(orderIndices);
+	benchmark::run("SpriteBatch::priv_updateAll (manual order)", Work{ 1u, numberOfSprites * 6u }, [&]()
+	{
+		batch.move({ 0.5f, 0.f });
+		target.draw(batch);
+	});
+	benchmark::run("SpriteBatch::draw (manual order, one sprite moved)", Work{ 1u }, [&]()
+	{
+		batch.move(0u, { 0.5f, 0.f });
+		target.draw(batch);
+	});
+	batch.clearAllOrdering();
+	benchmark::run("SpriteBatch::draw (one sprite moved)", Work{ 1u }, [&]()
+	{
+		batch.move(0u, { 0.5f, 0.f });
+		target.draw(batch);
+	});
+
+	// key order (e.g. depth): every key nudged each frame (nearly sorted), every key replaced each frame (unsorted) and no changes at all
+	batch.setUseKeyOrder(true);
+	std::vector<float> keys(numberOfSprites);
+	std::vector<float> keyChanges(numberOfSprites);
+	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+	{
+		keys[i] = sprites[i].getPosition().y;
+		keyChanges[i] = randomValue(-0.25f, 0.25f);
+	}
+	std::size_t frame{ 0u };
+	benchmark::run("SpriteBatch::priv_updateAll (key order, keys nudged)", Work{ 1u, numberOfSprites * 6u }, [&]()
+	{
+		++frame;
+		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+		{
+			keys[i] += keyChanges[(i + frame) % numberOfSprites];
+			batch.setKey(i, keys[i]);
+		}
+		target.draw(batch);
+	});
+	benchmark::run("SpriteBatch::priv_updateAll (key order, keys replaced)", Work{ 1u, numberOfSprites * 6u }, [&]()
+	{
+		++frame;
+		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+			batch.setKey(i, keyChanges[(i * 7919u + frame) % numberOfSprites] * 4000.f);
+		target.draw(batch);
+	});
+	benchmark::run("SpriteBatch::draw (key order, unchanged)", Work{ 1u }, [&]()
+	{
+		target.draw(batch);
+	});
+	batch.clearAllOrdering();
+
+	// quad generation throughput as the batch outgrows the caches (one operation is one sprite), then with every hardware thread generating quads
+	std::vector<std::size_t> threadCounts{ 1u };
+	if (std::thread::hardware_concurrency() > 1u)
+		threadCounts.push_back(std::thread::hardware_concurrency());
+	for (const std::size_t numberOfLargeBatchSprites : { 10000u, 100000u, 1000000u })
+	{
+		const auto name = [&](const std::size_t numberOfThreads)
+		{
+			return "SpriteBatch::priv_updateAll (" + std::to_string(numberOfLargeBatchSprites) + " sprites" + ((numberOfThreads == 1u) ? ")" : ", " + std::to_string(numberOfThreads) + " threads)");
+		};
+		if (std::none_of(threadCounts.begin(), threadCounts.end(), [&](const std::size_t numberOfThreads) { return benchmark::isSelected(name(numberOfThreads)); }))
+			continue;
+
+		sw::SpriteBatch largeBatch;
+		largeBatch.setTexture(texture);
+		largeBatch.setNumberOfSprites(numberOfLargeBatchSprites);
+		for (std::size_t i{ 0u }; i < numberOfLargeBatchSprites; ++i)
+		{
+			largeBatch.setTextureRect(i, { { 0, 0 }, { 16, 16 } });
+			largeBatch.setPosition(i, { randomValue(0.f, 1920.f), randomValue(0.f, 1080.f) });
+			largeBatch.setRotation(i, randomValue(0.f, 360.f));
+		}
+		for (const std::size_t numberOfThreads : threadCounts)
+		{
+			largeBatch.setNumberOfThreads(numberOfThreads);
+			benchmark::run(name(numberOfThreads), Work{ numberOfLargeBatchSprites, numberOfLargeBatchSprites * 6u }, [&]()
+			{
+				largeBatch.move({ 0.5f, 0.f });
+				target.draw(largeBatch);
+			});
+		}
+	}
+}
+
+void benchmarkTileMap(const bool isOpenGlAvailable)
+{
+	if (!isOpenGlAvailable || !benchmark::isSelected("TileMap::priv_updateVertices"))
+		return;
+
+	const sf::Vector2<std::size_t> levelSize{ 1000u, 1000u };
+	std::vector<int> level(levelSize.x * levelSize.y);
+	for (std::size_t i{ 0u }; i < level.size(); ++i)
+		level[i] = static_cast<int>(i % 64u);
+
+	const sf::Vector2<std::size_t> gridSize{ 41u, 24u };
+	sw::TileMap<int> tileMap;
+	tileMap.setLevel(level, levelSize.x);
+	tileMap.setGridSize(gridSize);
+	tileMap.setSize({ 1280.f, 720.f });
+	tileMap.setNumberOfTextureTilesPerRow(8u);
+	tileMap.setTextureTileSize({ 16u, 16u });
+	tileMap.setSmoothScroll(true);
+	float camera{ 0.f };
+	benchmark::run("TileMap::priv_updateVertices (with render)", Work{ 1u, gridSize.x * gridSize.y * 6u }, [&]()
+	{
+		camera += 0.37f;
+		tileMap.setCamera({ camera, camera * 0.5f });
+		tileMap.update();
+		tileMap.redraw();
+	});
+}
+
+void benchmarkSpline()
+{
+	const std::size_t numberOfVertices{ 100u };
+	sw::Spline spline(numberOfVertices);
+	for (std::size_t i{ 0u }; i < numberOfVertices; ++i)
+		spline[i].position = { i * 10.f, 300.f + std::sin(i * 0.5f) * 100.f };
+	spline.setInterpolationSteps(10u);
+	spline.setBezierInterpolation();
+	spline.smoothHandles();
+	spline.setThickness(8.f);
+	spline.setThickCornerType(sw::Spline::ThickCornerType::Bevel);
+	spline.update();
+	const std::size_t numberOfOutputVertices{ (spline.getInterpolatedPositionCount() - 2u) * 4u + 4u }; // open bevelled thick spline: 4 per corner and 2 per end
+
+	float offset{ 0.f };
+	benchmark::run("Spline::update", Work{ 1u, numberOfOutputVertices }, [&]()
+	{
+		offset = -offset + 0.25f;
+		spline[numberOfVertices / 2u].position.y += offset;
+		spline.update();
+	});
+}
+
+void benchmarkPolygon()
+{
+	const std::size_t numberOfVertices{ 200u };
+	sw::Polygon polygon;
+	polygon.setNumberOfVertices(numberOfVertices);
+	for (std::size_t i{ 0u }; i < numberOfVertices; ++i)
+	{
+		const float angle{ -6.2831853f * i / numberOfVertices }; // anticlockwise
+		const float radius{ (i % 2u == 0u) ? 300.f : randomValue(120.f, 280.f) }; // star-shaped (concave) outline
+		polygon.setVertexPosition(i, { 400.f + std::cos(angle) * radius, 400.f + std::sin(angle) * radius });
+	}
+
+	for (const auto method : { sw::Polygon::TriangulationMethod::BasicEarClip, sw::Polygon::TriangulationMethod::EarClip })
+	{
+		polygon.setTriangulationMethod(method);
+		const std::string methodName{ (method == sw::Polygon::TriangulationMethod::BasicEarClip) ? "basic ear clip" : "ear clip" };
+		benchmark::run("Polygon::update (" + methodName + ")", Work{ 1u, (numberOfVertices - 2u) * 3u }, [&]() { polygon.update(); });
+	}
+}
+
+void benchmarkSprite3d()
+{
+	const sf::Texture texture;
+	benchmark::NullRenderTarget target;
+	sw::Sprite3d sprite(texture);
+	sprite.setTextureRect({ { 0, 0 }, { 256, 256 } });
+	sprite.setMeshDensity(16u);
+	sprite.setPosition({ 400.f, 300.f });
+	const std::size_t meshDensity{ sprite.getSubdividedMeshDensity() };
+	const std::size_t numberOfVertices{ 2u * meshDensity * meshDensity + 5u * meshDensity + 4u };
+
+	float yaw{ 0.f };
+	benchmark::run("Sprite3d::updateTransformedPoints", Work{ 1u, numberOfVertices }, [&]()
+	{
+		yaw += 0.7f;
+		sprite.setRotation3d({ yaw * 0.5f, yaw, 0.f });
+		target.draw(sprite);
+	});
+}
+
+void benchmarkStarfield3d()
+{
+	const std::size_t numberOfStars{ 10000u };
+	benchmark::NullRenderTarget target;
+	sw::Starfield3d starfield({ 1280.f, 720.f }, numberOfStars);
+	benchmark::run("Starfield3d::move", Work{ 1u, numberOfStars * 6u }, [&]()
+	{
+		starfield.move({ 1.f, 0.5f, 2000.f });
+		target.draw(starfield);
+	});
+}
+
+void benchmarkPixelDisplay(const bool isOpenGlAvailable)
+{
+	// a full-screen update of a 640x360 display (e.g. a palette change) with each render mode
+	const sf::Vector2<std::size_t> resolution{ 640u, 360u };
+	const std::size_t numberOfPixels{ resolution.x * resolution.y };
+	for (const sw::PixelDisplay::RenderMode renderMode : { sw::PixelDisplay::RenderMode::Vertices, sw::PixelDisplay::RenderMode::Texture })
+	{
+		const bool isTextureMode{ renderMode == sw::PixelDisplay::RenderMode::Texture };
+		const std::string modeName{ isTextureMode ? "texture" : "vertices" };
+		benchmark::NullRenderTarget target;
+		sw::PixelDisplay pixelDisplay;
+		pixelDisplay.setRenderMode(renderMode);
+		pixelDisplay.setResolution(resolution);
+		std::size_t color{ 0u };
+		benchmark::run("PixelDisplay::fill (" + modeName + ")", Work{ 1u, isTextureMode ? 0u : numberOfPixels * 6u, numberOfPixels * (isTextureMode ? sizeof(sf::Color) : sizeof(sf::Color) * 6u), 1u }, [&]()
+		{
+			color = (color + 1u) % 16u;
+			pixelDisplay.fill(color);
+			target.draw(pixelDisplay); // changes are applied when drawn
+		});
+
+		// a frame of small edits: sixteen 4x4 sprites stamped, then drawn
+		const std::size_t spriteBufferIndex{ pixelDisplay.addBuffer({ 4u, 4u }) };
+		std::size_t frame{ 0u };
+		benchmark::run("PixelDisplay::paste (16 sprites, " + modeName + ")", Work{ 1u, isTextureMode ? 0u : 16u * 16u * 6u, 0u, 1u }, [&]()
+		{
+			++frame;
+			for (std::size_t i{ 0u }; i < 16u; ++i)
+				pixelDisplay.paste(spriteBufferIndex, { static_cast<int>((frame * 7u + i * 37u) % 636u), static_cast<int>((frame * 3u + i * 19u) % 356u) });
+			target.draw(pixelDisplay);
+		});
+
+		// sixteen 24x24 filled rectangles, set one pixel at a time and then with the raster primitive
+		const auto rectanglePosition = [&](const std::size_t i) { return sf::Vector2i{ static_cast<int>((frame * 7u + i * 37u) % 616u), static_cast<int>((frame * 3u + i * 19u) % 336u) }; };
+		benchmark::run("PixelDisplay::setPixel (16 rectangles, " + modeName + ")", Work{ 16u * 24u * 24u, isTextureMode ? 0u : 16u * 24u * 24u * 6u, 0u, 1u }, [&]()
+		{
+			++frame;
+			for (std::size_t i{ 0u }; i < 16u; ++i)
+			{
+				const sf::Vector2i position{ rectanglePosition(i) };
+				for (int y{ 0 }; y < 24; ++y)
+				{
+					for (int x{ 0 }; x < 24; ++x)
+						pixelDisplay.setPixel(static_cast<std::size_t>(position.y + y) * resolution.x + static_cast<std::size_t>(position.x + x), i);
+				}
+			}
+			target.draw(pixelDisplay);
+		});
+		benchmark::run("PixelDisplay::fillRectangle (16 rectangles, " + modeName + ")", Work{ 16u * 24u * 24u, isTextureMode ? 0u : 16u * 24u * 24u * 6u, 0u, 1u }, [&]()
+		{
+			++frame;
+			for (std::size_t i{ 0u }; i < 16u; ++i)
+				pixelDisplay.fillRectangle({ rectanglePosition(i), { 24, 24 } }, i);
+			target.draw(pixelDisplay);
+		});
+
+		// palette cycling (e.g. animated water) each frame
+		pixelDisplay.setSeed(1u);
+		pixelDisplay.randomize();
+		benchmark::run("PixelDisplay::cyclePaletteUp (" + modeName + ")", Work{ 1u, isTextureMode ? 0u : numberOfPixels * 6u, 0u, 1u }, [&]()
+		{
+			pixelDisplay.cyclePaletteUp(1u, 8u, 8u);
+			target.draw(pixelDisplay);
+		});
+
+		if (!isOpenGlAvailable)
+			continue;
+
+		sf::RenderTexture renderTexture;
+		if (!renderTexture.resize({ 1280u, 720u }))
+			continue;
+		std::size_t index{ 0u };
+		benchmark::run("PixelDisplay::draw (pixel set, " + modeName + ")", Work{ 1u, isTextureMode ? 6u : numberOfPixels * 6u, 0u, 1u }, [&]()
+		{
+			pixelDisplay.setPixel(index, index % 16u);
+			index = (index + 1u) % numberOfPixels;
+			renderTexture.draw(pixelDisplay);
+			renderTexture.display();
+		});
+
+		if (isTextureMode && pixelDisplay.setUseShader(true))
+		{
+			benchmark::run("PixelDisplay::cyclePaletteUp (texture, shader)", Work{ 1u, 6u, 0u, 1u }, [&]()
+			{
+				pixelDisplay.cyclePaletteUp(1u, 8u, 8u);
+				renderTexture.draw(pixelDisplay);
+				renderTexture.display();
+			});
+		}
+	}
+}
+
+template <class IndexType>
+void benchmarkPixelDisplayIndexType(const std::string& indexTypeName)
+{
+	// moving indices around (scroll, copy and paste) with a narrower pixel index type. the display is never drawn so only the index traffic is measured
+	const sf::Vector2<std::size_t> resolution{ 640u, 360u };
+	const std::size_t numberOfPixels{ resolution.x * resolution.y };
+	const std::size_t indexBytes{ numberOfPixels * sizeof(IndexType) };
+	sw::BasicPixelDisplay<IndexType> pixelDisplay;
+	pixelDisplay.setRenderMode(sw::BasicPixelDisplay<IndexType>::RenderMode::Texture);
+	pixelDisplay.setResolution(resolution);
+	pixelDisplay.setSeed(1u);
+	pixelDisplay.randomize();
+	const std::size_t bufferIndex{ pixelDisplay.copy() };
+	benchmark::run("PixelDisplay::scrollWrapUp (" + indexTypeName + ")", Work{ 1u, 0u, indexBytes * 2u }, [&]()
+	{
+		pixelDisplay.scrollWrapUp();
+	});
+	benchmark::run("PixelDisplay::copy/paste (" + indexTypeName + ")", Work{ 1u, 0u, indexBytes * 2u }, [&]()
+	{
+		pixelDisplay.copy(bufferIndex);
+		pixelDisplay.paste(bufferIndex);
+	});
+}
+
+void benchmarkRandom()
+{
+	// the same mix of draws that the drawables make: a byte (ConsoleScreen::crash) and a float in a range (Starfield)
+	const std::size_t numberOfValues{ 100000u };
+	volatile float result{ 0.f }; // keeps the generated values from being optimised away
+
+	std::mt19937 generator{ 1u };
+	benchmark::run("Random (std::mt19937)", Work{ numberOfValues, 0u, numberOfValues * 8u }, [&]()
+	{
+		float sum{ 0.f };
+		for (std::size_t i{ 0u }; i < numberOfValues; ++i)
+			sum += static_cast<float>(std::uniform_int_distribution<std::uint32_t>(0u, 255u)(generator)) + std::uniform_real_distribution<float>(0.f, 1280.f)(generator);
+		result = sum;
+	});
+
+	sw::Random random{ 1u };
+	benchmark::run("Random (sw::Random)", Work{ numberOfValues, 0u, numberOfValues * 8u }, [&]()
+	{
+		float sum{ 0.f };
+		for (std::size_t i{ 0u }; i < numberOfValues; ++i)
+			sum += static_cast<float>(random.getInteger(255u)) + random.getFloat(0.f, 1280.f);
+		result = sum;
+	});
+}
+
+void benchmarkBitmapText()
+{
+	const sf::Texture texture;
+	sw::BitmapFont font;
+	font.setExternalTexture(texture);
+	font.setNumberOfTilesPerRow(16u);
+	font.setDefaultTextureRect({ { 0, 0 }, { 8, 8 } });
+	font.setKerning(-1, "AVVAToTy");
+
+	std::string strings[2u]{ std::string(), std::string() };
+	while (strings[0u].size() < 1000u)
+	{
+		strings[0u] += "AV To Ty 0123456789 The quick brown fox. ";
+		strings[1u] += "Jumps over the lazy dog; AVAVTo 9876543210 ";
+	}
+	strings[0u].resize(1000u);
+	strings[1u].resize(1000u);
+
+	sw::BitmapText text;
+	text.setBitmapFont(font);
+	std::size_t current{ 0u };
+	benchmark::run("BitmapText::priv_updateVertices", Work{ 1u, strings[0u].size() * 6u }, [&]()
+	{
+		current = 1u - current;
+		text.setString(strings[current]);
+	});
+}
+
+// counts the submissions (draw calls when drawing directly) and the vertices of a drawable without drawing it
+class CountingVertexSink : public sw::VertexSink
+{
+public:
+	void append(const sf::Vertex*, const std::size_t numberOfVertices, sf::PrimitiveType, const sf::RenderStates&) override
+	{
+		++numberOfAppends;
+		this->numberOfVertices += numberOfVertices;
+	}
+
+	std::size_t numberOfAppends{ 0u };
+	std::size_t numberOfVertices{ 0u };
+};
+
+void benchmarkVertexSink()
+{
+	// a HUD of many small drawables sharing one texture: drawn one at a time, appended into one vertex array and drawn with a single call, or batched
+	const sf::Texture texture;
+	sw::BitmapFont font;
+	font.setExternalTexture(texture);
+	font.setNumberOfTilesPerRow(16u);
+	font.setDefaultTextureRect({ { 0, 0 }, { 8, 8 } });
+
+	constexpr std::size_t numberOfEachDrawable{ 100u };
+	std::vector<sw::NinePatch> panels(numberOfEachDrawable);
+	std::vector<sw::Ring> rings(numberOfEachDrawable);
+	std::vector<sw::BitmapText> labels(numberOfEachDrawable);
+	std::vector<sw::ProgressBar> bars(numberOfEachDrawable);
+	for (std::size_t i{ 0u }; i < numberOfEachDrawable; ++i)
+	{
+		const sf::Vector2f position{ randomValue(0.f, 1800.f), randomValue(0.f, 1000.f) };
+		panels[i].setTexture(texture);
+		panels[i].setSize({ 120.f, 40.f });
+		panels[i].setPosition(position);
+		rings[i] = sw::Ring{ 12.f, 0.6f, 24u };
+		rings[i].setTexture(texture);
+		rings[i].setPosition(position + sf::Vector2f{ 4.f, 4.f });
+		labels[i].setBitmapFont(font);
+		labels[i].setString("Score " + std::to_string(i));
+		labels[i].setPosition(position + sf::Vector2f{ 32.f, 8.f });
+		bars[i].setSize({ 80.f, 6.f });
+		bars[i].setTexture(texture);
+		bars[i].setBackgroundTexture(texture);
+		bars[i].setShowBackgroundAndFrame(true);
+		bars[i].setFrameThickness(0.f); // a frame is untextured so would prevent merging with the rest of the HUD
+		bars[i].setRatio(randomValue(0.f, 1.f));
+		bars[i].setPosition(position + sf::Vector2f{ 32.f, 28.f });
+	}
+
+	CountingVertexSink counter;
+	for (std::size_t i{ 0u }; i < numberOfEachDrawable; ++i)
+	{
+		panels[i].appendVertices(counter);
+		rings[i].appendVertices(counter);
+		labels[i].appendVertices(counter);
+		bars[i].appendVertices(counter);
+	}
+
+	benchmark::NullRenderTarget target;
+	benchmark::run("VertexSink HUD (individual draws)", Work{ 1u, counter.numberOfVertices, 0u, counter.numberOfAppends }, [&]()
+	{
+		for (std::size_t i{ 0u }; i < numberOfEachDrawable; ++i)
+		{
+			target.draw(panels[i]);
+			target.draw(rings[i]);
+			target.draw(labels[i]);
+			target.draw(bars[i]);
+		}
+	});
+
+	std::vector<sf::Vertex> vertices;
+	benchmark::run("VertexSink HUD (appended, single draw)", Work{ 1u, counter.numberOfVertices, 0u, 1u }, [&]()
+	{
+		vertices.clear();
+		for (std::size_t i{ 0u }; i < numberOfEachDrawable; ++i)
+		{
+			panels[i].appendVertices(vertices);
+			rings[i].appendVertices(vertices);
+			labels[i].appendVertices(vertices);
+			bars[i].appendVertices(vertices);
+		}
+		target.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates{ &texture });
+	});
+
+	sw::RenderBatcher batcher;
+	const auto batchHud = [&]()
+	{
+		batcher.clear();
+		for (std::size_t i{ 0u }; i < numberOfEachDrawable; ++i)
+		{
+			batcher.add(panels[i]);
+			batcher.add(rings[i]);
+			batcher.add(labels[i]);
+			batcher.add(bars[i]);
+		}
+	};
+	batchHud();
+	benchmark::run("RenderBatcher HUD", Work{ 1u, counter.numberOfVertices, 0u, batcher.getNumberOfBatches() }, [&]()
+	{
+		batchHud();
+		target.draw(batcher);
+	});
+}
+
+void benchmarkVertexBuffer(const bool isOpenGlAvailable)
+{
+	// the cost of drawing (including uploading) a mostly unchanged display each frame, from client-side arrays or from vertex buffers
+	if (!isOpenGlAvailable || !benchmark::isSelected("::draw ("))
+		return;
+
+	sf::RenderTexture renderTexture;
+	if (!renderTexture.resize({ 1280u, 720u }))
+		return;
+
+	for (const bool useVertexBuffer : { false, true })
+	{
+		const sf::Vector2u mode{ 160u, 90u };
+		sw::ConsoleScreen console(mode);
+		console.setShowCursor(false);
+		console.setUseVertexBuffer(useVertexBuffer, sf::VertexBuffer::Usage::Stream);
+		const std::string row(mode.x, '#');
+		benchmark::run(std::string("ConsoleScreen::draw (row printed") + (useVertexBuffer ? ", vertex buffer)" : ")"), Work{ 1u, console.getNumberOfCells() * 12u, 0u, 2u }, [&]()
+		{
+			console << sw::ConsoleScreen::Location(0u, 10u) << row;
+			renderTexture.draw(console);
+			renderTexture.display();
+		});
+	}
+
+	for (const bool useVertexBuffer : { false, true })
+	{
+		sw::PixelDisplay pixelDisplay;
+		pixelDisplay.setUseVertexBuffer(useVertexBuffer, sf::VertexBuffer::Usage::Stream);
+		const std::size_t numberOfVertices{ pixelDisplay.getResolution().x * pixelDisplay.getResolution().y * 6u };
+		std::size_t index{ 0u };
+		benchmark::run(std::string("PixelDisplay::draw (pixel set") + (useVertexBuffer ? ", vertex buffer)" : ")"), Work{ 1u, numberOfVertices, 0u, 1u }, [&]()
+		{
+			pixelDisplay.setPixel(index, index % 16u);
+			index = (index + 1u) % (numberOfVertices / 6u);
+			renderTexture.draw(pixelDisplay);
+			renderTexture.display();
+		});
+	}
+}
+
+} // namespace
+
+int main(const int argc, char* argv[])
+{
+	bool isOpenGlAvailable{ false };
+	for (int i{ 1 }; i < argc; ++i)
+	{
+		const std::string argument{ argv[i] };
+		if (argument == "--gl")
+			isOpenGlAvailable = true;
+		else if ((argument == "--duration") && (i + 1 < argc))
+			benchmark::settings.minimumDuration = std::atof(argv[++i]);
+		else
+			benchmark::settings.filter = argument;
+	}
+
+	benchmark::printHeader();
+	benchmarkConsoleScreen();
+	benchmarkSpriteBatch();
+	benchmarkTileMap(isOpenGlAvailable);
+	benchmarkSpline();
+	benchmarkPolygon();
+	benchmarkSprite3d();
+	benchmarkStarfield3d();
+	benchmarkPixelDisplay(isOpenGlAvailable);
+	benchmarkPixelDisplayIndexType<std::uint32_t>("32-bit");
+	benchmarkPixelDisplayIndexType<std::uint8_t>("8-bit");
+	benchmarkRandom();
+	benchmarkBitmapText();
+	benchmarkVertexSink();
+	benchmarkVertexBuffer(isOpenGlAvailable);
+
+	return EXIT_SUCCESS;
+}
@@ -43,6 +43,8 @@
 #include "SelbaWard/PixelDisplay.hpp"
 #include "SelbaWard/Polygon.hpp"
 #include "SelbaWard/ProgressBar.hpp"
+#include "SelbaWard/Random.hpp"
+#include "SelbaWard/RenderBatcher.hpp"
 #include "SelbaWard/Ring.hpp"
 #include "SelbaWard/SpinningCard.hpp"
 #include "SelbaWard/Spline.hpp"
@@ -51,5 +53,7 @@
 #include "SelbaWard/Starfield.hpp"
 #include "SelbaWard/Starfield3d.hpp"
 #include "SelbaWard/TileMap.hpp"
+#include "SelbaWard/VertexBufferCache.hpp"
+#include "SelbaWard/VertexSink.hpp"
 
 #endif // SELBAWARD_HPP
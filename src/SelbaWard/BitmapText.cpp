@@ -146,18 +146,30 @@ sf::Vector2f BitmapText::getTextureTrim() const
 	return m_texTrim;
 }
 
-
-
-// PRIVATE
-
-void BitmapText::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void BitmapText::appendVertices(VertexSink& sink, sf::RenderStates states) const
 {
 	if (m_vertices.empty())
 		return;
 
 	states.transform *= getTransform();
 	states.texture = m_pBitmapFont->getTexture();
-	target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+	sink.append(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+}
+
+void BitmapText::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
+{
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
+
+
+
+// PRIVATE
+
+void BitmapText::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	RenderTargetVertexSink sink{ target };
+	appendVertices(sink, states);
 }
 
 void BitmapText::priv_updateVertices()
@@ -34,6 +34,7 @@
 #define SELBAWARD_BITMAPTEXT_HPP
 
 #include "Common.hpp"
+#include "VertexSink.hpp"
 #include "BitmapFont.hpp"
 #include <SFML/Graphics/VertexArray.hpp>
 
@@ -64,6 +65,10 @@ public:
 	sf::Vector2f getCharacterTrim() const;
 	sf::Vector2f getTextureTrim() const;
 
+	// vertex sink
+	void appendVertices(VertexSink& sink, sf::RenderStates states = sf::RenderStates::Default) const; // submits what would be drawn to a sink instead of a render target
+	void appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform = sf::Transform::Identity) const; // appends what would be drawn as transformed triangles
+
 private:
 	const BitmapFont* m_pBitmapFont;
 	std::vector<sf::Vertex> m_vertices;
@@ -32,11 +32,13 @@
 
 #include "ConsoleScreen.hpp"
 
-#include <random>
 #include <functional>
 #include <algorithm>
+#include <limits>
+#include <memory>
 #include <SFML/Config.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector3.hpp>
 
 namespace
 {
@@ -51,33 +53,59 @@ const selbaward::ConsoleScreen::Color defaultCursorColor(selbaward::ConsoleScree
 const selbaward::ConsoleScreen::Cell defaultCell{ 0u, selbaward::ConsoleScreen::ColorPair(), selbaward::ConsoleScreen::StretchType::None, selbaward::ConsoleScreen::CellAttributes() };
 selbaward::ConsoleScreen::Cell fakeCell = defaultCell;
 
-std::mt19937 randomGenerator;
-const std::uniform_int_distribution<unsigned short int> randomDistribution(0u, 255u);
-std::function <unsigned short int()> getRandomByteValue;
+constexpr std::size_t noEditedCellIndex{ std::numeric_limits<std::size_t>::max() };
+constexpr std::size_t noScrollbackRow{ std::numeric_limits<std::size_t>::max() };
+constexpr unsigned int maximumReverseCharacterMapValue{ 65535u }; // larger mapped values are found by searching the character map
+constexpr std::int16_t noReverseCharacter{ -1 };
 
-inline void randomSeed()
+inline void packColorId(std::uint8_t (&bytes)[3], const long int colorId)
 {
-	std::random_device rd;
-	randomGenerator.seed(rd());
-	getRandomByteValue = std::bind(randomDistribution, randomGenerator);
+	const unsigned long int magnitude{ static_cast<unsigned long int>((colorId < 0) ? -colorId : colorId) };
+	bytes[0u] = static_cast<std::uint8_t>(magnitude & 0xFFu);
+	bytes[1u] = static_cast<std::uint8_t>((magnitude >> 8u) & 0xFFu);
+	bytes[2u] = static_cast<std::uint8_t>((magnitude >> 16u) & 0xFFu);
 }
 
-inline unsigned char randomByte()
+inline long int unpackColorId(const std::uint8_t (&bytes)[3])
 {
-	return static_cast<unsigned char>(getRandomByteValue());
+	return static_cast<long int>(bytes[0u]) | (static_cast<long int>(bytes[1u]) << 8u) | (static_cast<long int>(bytes[2u]) << 16u);
 }
 
-inline float linearInterpolation(const float start, const float end, const float alpha)
+constexpr unsigned int maximumPaletteSizeForLinearSearch{ 16u };
+constexpr unsigned int paletteLookupRegionSize{ 16u }; // size of each cubic region of colour space (in each channel)
+constexpr unsigned int paletteLookupRegionsPerChannel{ 256u / paletteLookupRegionSize };
+
+constexpr char escapeCharacter{ '\x1B' };
+constexpr std::size_t maximumNumberOfStreamParameters{ 16u };
+
+inline bool isStreamControlCharacter(const char character)
 {
-	return start * (1 - alpha) + end * alpha;
+	return (static_cast<unsigned char>(character) < 0x20u) || (character == 0x7F);
 }
 
-inline unsigned int valueFromChar(char character)
+inline sf::Color xtermColor(const unsigned int colorNumber)
 {
-	if (character < 0)
-		return static_cast<unsigned int>(character + 256);
-	else
-		return static_cast<unsigned int>(character);
+	// 16 standard colours, a 6x6x6 colour cube and a 24-step grayscale ramp
+	static const sf::Color standardColors[16u]
+	{
+		{ 0u, 0u, 0u }, { 205u, 0u, 0u }, { 0u, 205u, 0u }, { 205u, 205u, 0u }, { 0u, 0u, 238u }, { 205u, 0u, 205u }, { 0u, 205u, 205u }, { 229u, 229u, 229u },
+		{ 127u, 127u, 127u }, { 255u, 0u, 0u }, { 0u, 255u, 0u }, { 255u, 255u, 0u }, { 92u, 92u, 255u }, { 255u, 0u, 255u }, { 0u, 255u, 255u }, { 255u, 255u, 255u }
+	};
+	if (colorNumber < 16u)
+		return standardColors[colorNumber];
+	if (colorNumber < 232u)
+	{
+		const auto level = [](const unsigned int step) { return static_cast<std::uint8_t>((step == 0u) ? 0u : 55u + step * 40u); };
+		const unsigned int cubeIndex{ colorNumber - 16u };
+		return{ level(cubeIndex / 36u), level((cubeIndex / 6u) % 6u), level(cubeIndex % 6u) };
+	}
+	const std::uint8_t gray{ static_cast<std::uint8_t>(8u + (std::min(colorNumber, 255u) - 232u) * 10u) };
+	return{ gray, gray, gray };
+}
+
+inline float linearInterpolation(const float start, const float end, const float alpha)
+{
+	return start * (1 - alpha) + end * alpha;
 }
 
 inline void swapColors(sf::Color& a, sf::Color& b)
@@ -323,6 +351,41 @@ void addPalette256ColorSepia(std::vector<sf::Color>& palette)
 		addColorToPalette(palette, sepiaColor(static_cast<float>(i) / (numberOfColors - 1u)));
 }
 
+// draws to a render target, taking any vertices that are part of a display with a vertex buffer from that buffer
+class DisplayVertexBufferSink : public selbaward::VertexSink
+{
+public:
+	struct Display
+	{
+		const std::vector<sf::Vertex>* vertices;
+		selbaward::VertexBufferCache* vertexBuffer;
+	};
+
+	DisplayVertexBufferSink(sf::RenderTarget& target, const std::array<Display, 2u>& displays)
+		: m_target(target)
+		, m_displays(displays)
+	{
+	}
+
+	void append(const sf::Vertex* const vertices, const std::size_t numberOfVertices, const sf::PrimitiveType primitiveType, const sf::RenderStates& states) override
+	{
+		for (auto& display : m_displays)
+		{
+			const sf::Vertex* const begin{ display.vertices->data() };
+			if (std::less_equal<const sf::Vertex*>{}(begin, vertices) && std::less<const sf::Vertex*>{}(vertices, begin + display.vertices->size()))
+			{
+				display.vertexBuffer->draw(m_target, *display.vertices, static_cast<std::size_t>(vertices - begin), numberOfVertices, primitiveType, states);
+				return;
+			}
+		}
+		m_target.draw(vertices, numberOfVertices, primitiveType, states);
+	}
+
+private:
+	sf::RenderTarget& m_target;
+	const std::array<Display, 2u> m_displays;
+};
+
 } // namespace
 
 namespace selbaward
@@ -365,17 +428,14 @@ ConsoleScreen& ConsoleScreen::operator<<(const Location& location)
 {
 	const unsigned int currentIndex{ priv_getCurrentPrintProperties().index };
 	priv_getCurrentPrintProperties().index = priv_getPrintIndex(location);
-	if (m_do.updateAutomatically)
+	priv_markCellForUpdate(currentIndex);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
+		priv_markCellForUpdate(currentIndex + m_mode.x);
+	if (priv_getCurrentPrintProperties().index != currentIndex)
 	{
-		priv_updateCell(currentIndex);
+		priv_markCellForUpdate(priv_getPrintIndex(location));
 		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-			priv_updateCell(currentIndex + m_mode.x);
-		if (priv_getCurrentPrintProperties().index != currentIndex)
-		{
-			priv_updateCell(priv_getPrintIndex(location));
-			if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-				priv_updateCell(priv_getPrintIndex(location) + m_mode.x);
-		}
+			priv_markCellForUpdate(priv_getPrintIndex(location) + m_mode.x);
 	}
 	return *this;
 }
@@ -424,11 +484,7 @@ ConsoleScreen& ConsoleScreen::operator<<(const sf::Color& newColor)
 	if (m_do.addNewColorToPalette)
 		addColorToPalette(newColor);
 	else
-	{
-		color.id = priv_getIndexOfClosestPaletteColor(newColor);
-		if (color.id < 0)
-			color.id = 0;
-	}
+		color = getClosestPaletteColor(newColor);
 	return *this << color;
 }
 
@@ -460,8 +516,8 @@ ConsoleScreen& ConsoleScreen::operator<<(const StretchType& stretchType)
 	priv_getCurrentPrintProperties().stretch = stretchType;
 	if (stretchType == Cs::StretchType::Both)
 		priv_testCursorForScroll();
-	if (m_do.updateAutomatically)
-		update();
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
 	return *this;
 }
 
@@ -508,15 +564,12 @@ ConsoleScreen& ConsoleScreen::operator<<(const MovementControl& movementControl)
 		else
 			priv_testCursorForScroll();
 	}
-	if (m_do.updateAutomatically)
+	priv_markCellForUpdate(currentIndex);
+	priv_markCellForUpdate(printProperties.index);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
 	{
-		priv_updateCell(currentIndex);
-		priv_updateCell(printProperties.index);
-		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-		{
-			priv_updateCell(currentIndex + m_mode.x);
-			priv_updateCell(printProperties.index + m_mode.x);
-		}
+		priv_markCellForUpdate(currentIndex + m_mode.x);
+		priv_markCellForUpdate(printProperties.index + m_mode.x);
 	}
 	return *this;
 }
@@ -636,17 +689,19 @@ ConsoleScreen& ConsoleScreen::operator<<(const CursorCommand& cursorCommand)
 		else
 			priv_testCursorForScroll();
 	}
-	if (m_do.updateAutomatically)
-		update();
+	priv_markCellForUpdate(currentIndex);
+	priv_markCellForUpdate(currentIndex + m_mode.x);
+	priv_markCellForUpdate(printProperties.index);
+	priv_markCellForUpdate(printProperties.index + m_mode.x);
 	return *this;
 }
 
 ConsoleScreen& ConsoleScreen::operator>>(std::string& string)
 {
-	if (priv_isCellIndexInRange(priv_getCurrentPrintProperties().index))
-		string = priv_read(priv_getCurrentPrintProperties().index);
-	else
-		string = "";
+	// only the cells left on the screen can be read so no more than those are allocated
+	const unsigned int index{ priv_getCurrentPrintProperties().index };
+	string.resize(std::min<std::size_t>(m_readLength, priv_isCellIndexInRange(index) ? getNumberOfCells() - index : 0u));
+	string.resize(priv_read(index, string.data(), string.size()));
 	return *this;
 }
 
@@ -687,21 +742,44 @@ ConsoleScreen::ConsoleScreen(const sf::Vector2u mode)
 	, m_defaultPrintProperties{ 0u, ColorPair(defaultColor, defaultBackgroundColor), StretchType::None, CellAttributes(), Affect::Default, ColorType::Foreground }
 	, m_cells()
 	, m_mode(mode)
+	, m_rowOffset{ 0u }
 	, m_overCells()
 	, m_underCells()
 	, m_buffers()
+	, m_scrollbackCells(true)
+	, m_scrollbackSize{ 0u }
+	, m_scrollbackFirstRow{ 0u }
+	, m_numberOfScrollbackRows{ 0u }
+	, m_numberOfRowsAddedToScrollback{ 0u }
+	, m_scrollbackViewOffset{ 0u }
 	, m_cursor{ static_cast<int>('_'), defaultCursorColor, true, false, false }
 	, m_tabSize{ 4u }
 	, m_readLength{ 1u }
+	, m_stream{ StreamState::Text, {}, false, { 0u, 0u }, Affect::None }
+	, m_commandQueue()
 	, m_palette()
+	, m_paletteLookupRegions()
+	, m_isPaletteLookupValid{ false }
 	, m_characterMap()
+	, m_isCharacterMapped()
+	, m_characterMapReverse()
 	, m_characterMapCursorCommand()
+	, m_isCharacterMappedToCursorCommand()
 	, m_clearValue{ 0u }
 	, m_darkAttributeMultiplier{ 0.5f }
+	, m_rowUpdateRanges()
+	, m_isStackUpdateRequired{ false }
+	, m_numberOfCellsUpdated{ 0u }
+	, m_random()
 	, m_display()
 	, m_backgroundDisplay()
+	, m_displayVertexBuffer()
+	, m_backgroundDisplayVertexBuffer()
 	, m_overDisplay()
 	, m_underDisplay()
+	, m_scrollbackDisplay()
+	, m_scrollbackBackgroundDisplay()
+	, m_scrollbackDisplayRows()
 	, m_size{ 100.f, 100.f }
 	, m_texture{ nullptr }
 	, m_textureOffset{ 0u, 0u }
@@ -710,7 +788,11 @@ ConsoleScreen::ConsoleScreen(const sf::Vector2u mode)
 {
 	m_cursorPrintProperties = m_defaultPrintProperties;
 	m_directPrintProperties = m_defaultPrintProperties;
-	randomSeed();
+	for (unsigned int i{ 0u }; i < m_characterMap.size(); ++i)
+		m_characterMap[i] = i;
+	m_isCharacterMapped.fill(false);
+	m_characterMapCursorCommand.fill(CursorCommand::None);
+	m_isCharacterMappedToCursorCommand.fill(false);
 	loadPalette(Palette::Default);
 	setMode(m_mode);
 }
@@ -721,36 +803,39 @@ void ConsoleScreen::setMode(sf::Vector2u mode)
 		mode = { 0u, 0u };
 
 	m_mode = mode;
+	m_rowOffset = 0u;
 	m_cells.resize(m_mode.x * m_mode.y, defaultCell);
 	m_display.resize(m_cells.size() * 6u);
 	m_backgroundDisplay = m_display;
+	m_rowUpdateRanges.assign(m_mode.y, { 0u, 0u });
+	m_scrollbackDisplay.resize(m_display.size());
+	m_scrollbackBackgroundDisplay.resize(m_display.size());
+	m_scrollbackDisplayRows.resize(m_mode.y);
 
 	clear(Color(0));
 	clearStack();
+	clearScrollback();
 }
 
 void ConsoleScreen::setSize(const sf::Vector2f size)
 {
 	m_size = size;
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::setTextureOffset(const sf::Vector2u textureOffset)
 {
 	m_textureOffset = textureOffset;
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::setTextureTileSize(const sf::Vector2u tileSize)
 {
 	m_tileSize = tileSize;
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::setNumberOfTextureTilesPerRow(const unsigned int numberOfTextureTilesPerRow)
@@ -764,8 +849,15 @@ void ConsoleScreen::setNumberOfTextureTilesPerRow(const unsigned int numberOfTex
 
 	m_numberOfTilesPerRow = numberOfTextureTilesPerRow;
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
+}
+
+std::size_t ConsoleScreen::getCellMemoryFootprint() const
+{
+	std::size_t memoryFootprint{ m_cells.getMemoryFootprint() + m_scrollbackCells.getMemoryFootprint() };
+	for (const auto& buffer : m_buffers)
+		memoryFootprint += buffer.cells.getMemoryFootprint();
+	return memoryFootprint;
 }
 
 sf::Vector2u ConsoleScreen::getNumberOfTilesInTexture2d() const
@@ -777,36 +869,51 @@ void ConsoleScreen::setShowCursor(const bool showCursor)
 {
 	m_cursor.visible = showCursor;
 
-	if (m_do.updateAutomatically)
-	{
-		priv_updateCell(m_cursorPrintProperties.index);
-		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-			priv_updateCell(m_cursorPrintProperties.index + m_mode.x);
-	}
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
+		priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
 }
 
 void ConsoleScreen::setInvertCursor(const bool invertCursor)
 {
 	m_cursor.inverse = invertCursor;
 
-	if (m_do.updateAutomatically)
-	{
-		priv_updateCell(m_cursorPrintProperties.index);
-		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-			priv_updateCell(m_cursorPrintProperties.index + m_mode.x);
-	}
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
+		priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
 }
 
 void ConsoleScreen::setUseCursorColor(const bool useCursorColor)
 {
 	m_cursor.useOwnColour = useCursorColor;
 
-	if (m_do.updateAutomatically)
-	{
-		priv_updateCell(m_cursorPrintProperties.index);
-		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-			priv_updateCell(m_cursorPrintProperties.index + m_mode.x);
-	}
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
+		priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
+}
+
+void ConsoleScreen::setUseRowRingBuffer(const bool useRowRingBuffer)
+{
+	m_do.useRowRingBuffer = useRowRingBuffer;
+
+	if (!m_do.useRowRingBuffer)
+		priv_resetRowOffset();
+}
+
+void ConsoleScreen::setUsePackedCells(const bool usePackedCells)
+{
+	m_do.usePackedCells = usePackedCells;
+
+	m_cells.setPacked(m_do.usePackedCells);
+	for (auto& buffer : m_buffers)
+		buffer.cells.setPacked(m_do.usePackedCells);
+	priv_markAllCellsForUpdate();
+}
+
+void ConsoleScreen::setUseVertexBuffer(const bool useVertexBuffer, const sf::VertexBuffer::Usage usage)
+{
+	m_displayVertexBuffer.setEnabled(useVertexBuffer, usage);
+	m_backgroundDisplayVertexBuffer.setEnabled(useVertexBuffer, usage);
 }
 
 void ConsoleScreen::update()
@@ -823,11 +930,7 @@ void ConsoleScreen::update()
 		return;
 	}
 
-	for (unsigned int i{ 0u }; i < m_cells.size(); ++i)
-		priv_updateCell(i);
-
-	priv_updateUnderCells();
-	priv_updateOverCells();
+	priv_update();
 }
 
 sf::Vector2f ConsoleScreen::getLocationAtCoord(sf::Vector2f coord) const
@@ -852,36 +955,27 @@ void ConsoleScreen::setCursor(const int cellValue)
 {
 	m_cursor.value = cellValue;
 
-	if (m_do.updateAutomatically)
-	{
-		priv_updateCell(m_cursorPrintProperties.index);
-		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-			priv_updateCell(m_cursorPrintProperties.index + m_mode.x);
-	}
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
+		priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
 }
 
 void ConsoleScreen::setCursor(const char cellCharacter, bool mapCharacter)
 {
 	m_cursor.value = mapCharacter ? priv_getCellValueFromCharacter(cellCharacter) : static_cast<int>(cellCharacter);
 
-	if (m_do.updateAutomatically)
-	{
-		priv_updateCell(m_cursorPrintProperties.index);
-		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-			priv_updateCell(m_cursorPrintProperties.index + m_mode.x);
-	}
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
+		priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
 }
 
 void ConsoleScreen::setCursorColor(const Color& color)
 {
 	m_cursor.color = color;
 
-	if (m_do.updateAutomatically)
-	{
-		priv_updateCell(m_cursorPrintProperties.index);
-		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-			priv_updateCell(m_cursorPrintProperties.index + m_mode.x);
-	}
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
+		priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
 }
 
 void ConsoleScreen::print(const char character)
@@ -900,7 +994,7 @@ void ConsoleScreen::print(const char character)
 	bool doAlterValue{ (printProperties.affectBitmask & Affect::Value) == Affect::Value };
 	const unsigned int currentIndex{ printProperties.index };
 	if (doAlterValue)
-		m_cells[currentIndex].value = priv_getCellValueFromCharacter(character);
+		m_cells.edit(priv_storageIndex(currentIndex)).value = priv_getCellValueFromCharacter(character);
 
 	const unsigned int belowIndex{ currentIndex + m_mode.x };
 	bool isBelowCellInRange{ priv_isCellIndexInRange(belowIndex) };
@@ -913,10 +1007,13 @@ void ConsoleScreen::print(const char character)
 		{
 			priv_modifyCellUsingPrintProperties(belowIndex, PrintType::Current, StretchType::Bottom);
 			if (doAlterValue)
-				m_cells[belowIndex].value = m_cells[currentIndex].value;
+				m_cells.edit(priv_storageIndex(belowIndex)).value = m_cells.get(priv_storageIndex(currentIndex)).value;
 		}
 	}
-	
+	priv_markCellForUpdate(currentIndex); // marked before any scrolling so that the cell that was printed is the one updated
+	if (printProperties.stretch == Cs::StretchType::Both)
+		priv_markCellForUpdate(belowIndex);
+
 	++printProperties.index;
 	if ((printProperties.stretch == StretchType::Both) && (printProperties.index % m_mode.x == 0))
 		printProperties.index += m_mode.x;
@@ -925,24 +1022,25 @@ void ConsoleScreen::print(const char character)
 	else if (!priv_isCellIndexInRange(printProperties.index))
 		printProperties.index = static_cast<unsigned int>(m_cells.size()) - 1u;
 
-	if (m_do.updateAutomatically)
-	{
-		priv_updateCell(currentIndex);
-		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-			priv_updateCell(currentIndex + m_mode.x);
-		if (currentIndex != printProperties.index)
-		{
-			priv_updateCell(printProperties.index);
-			if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-				priv_updateCell(printProperties.index + m_mode.x);
-		}
-	}
+	priv_markCellForUpdate(printProperties.index);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
+		priv_markCellForUpdate(printProperties.index + m_mode.x);
 }
 
 void ConsoleScreen::print(const std::string& string)
 {
-	for (auto& character : string)
-		print(character);
+	// printable characters are written in runs, broken only by characters that are mapped to cursor commands
+	std::size_t runStart{ 0u };
+	while (runStart < string.size())
+	{
+		std::size_t runEnd{ runStart };
+		while (runEnd < string.size() && !getIsMappedCursorCommandCharacter(string[runEnd]))
+			++runEnd;
+		priv_printRun(string.data() + runStart, runEnd - runStart);
+		if (runEnd < string.size())
+			print(string[runEnd]);
+		runStart = runEnd + 1u;
+	}
 }
 
 void ConsoleScreen::print(const Location& location, char character)
@@ -961,6 +1059,108 @@ void ConsoleScreen::print(const Location& location, const std::string& string)
 	priv_getCurrentPrintProperties() = backupPrintProperties;
 }
 
+void ConsoleScreen::write(const char* const data, const std::size_t size)
+{
+	std::size_t i{ 0u };
+	while (i < size)
+	{
+		const char character{ data[i] };
+		switch (m_stream.state)
+		{
+		case StreamState::Text:
+		{
+			// printable characters are printed as a single run
+			std::size_t runEnd{ i };
+			while (runEnd < size && !isStreamControlCharacter(data[runEnd]))
+				++runEnd;
+			if (runEnd > i)
+			{
+				priv_printRun(data + i, runEnd - i);
+				i = runEnd;
+				continue;
+			}
+			if (character == escapeCharacter)
+				m_stream.state = StreamState::Escape;
+			else
+				priv_executeStreamControlCharacter(character);
+		}
+			break;
+		case StreamState::Escape:
+			if (character == '[')
+			{
+				m_stream.state = StreamState::ControlSequence;
+				m_stream.parameters.clear();
+				m_stream.isPrivateSequence = false;
+			}
+			else if (character == ']' || character == 'P' || character == 'X' || character == '^' || character == '_')
+				m_stream.state = StreamState::String;
+			else if (character >= 0x20 && character <= 0x2F)
+				; // intermediate characters (e.g. character set selection) are ignored until the final character
+			else
+			{
+				if (character == '7')
+					m_stream.savedLocation = priv_cellLocation(priv_getCurrentPrintProperties().index);
+				else if (character == '8')
+					*this << m_stream.savedLocation;
+				else if (isStreamControlCharacter(character))
+					priv_executeStreamControlCharacter(character);
+				m_stream.state = (character == escapeCharacter) ? StreamState::Escape : StreamState::Text;
+			}
+			break;
+		case StreamState::ControlSequence:
+			if (character >= '0' && character <= '9')
+			{
+				if (m_stream.parameters.empty())
+					m_stream.parameters.push_back(0u);
+				unsigned int& parameter{ m_stream.parameters.back() };
+				parameter = std::min(parameter * 10u + static_cast<unsigned int>(character - '0'), 65535u);
+			}
+			else if (character == ';' || character == ':')
+			{
+				if (m_stream.parameters.empty())
+					m_stream.parameters.push_back(0u);
+				if (m_stream.parameters.size() < maximumNumberOfStreamParameters)
+					m_stream.parameters.push_back(0u);
+			}
+			else if (character >= 0x3C && character <= 0x3F)
+				m_stream.isPrivateSequence = true;
+			else if (character >= 0x40 && character <= 0x7E)
+			{
+				priv_executeStreamControlSequence(character);
+				m_stream.state = StreamState::Text;
+			}
+			else if (character == escapeCharacter)
+				m_stream.state = StreamState::Escape;
+			else if (character == 0x18 || character == 0x1A) // cancel
+				m_stream.state = StreamState::Text;
+			else if (isStreamControlCharacter(character))
+				priv_executeStreamControlCharacter(character);
+			break;
+		case StreamState::String:
+			if (character == 0x07) // bell terminates
+				m_stream.state = StreamState::Text;
+			else if (character == escapeCharacter)
+				m_stream.state = StreamState::StringEscape;
+			break;
+		case StreamState::StringEscape:
+			// "ESC \" (string terminator) terminates
+			m_stream.state = (character == '\\') ? StreamState::Text : StreamState::String;
+			break;
+		}
+		++i;
+	}
+}
+
+void ConsoleScreen::write(const std::string& string)
+{
+	write(string.data(), string.size());
+}
+
+void ConsoleScreen::processQueue()
+{
+	m_commandQueue.process(*this);
+}
+
 void ConsoleScreen::addOverAt(const Location& location, const char character, const sf::Vector2f offset)
 {
 	if (getIsMappedCursorCommandCharacter(character))
@@ -1027,8 +1227,7 @@ void ConsoleScreen::addOverAt(const Location& location, const Cell& cell, const
 	if (m_overCells.back().cell.colors.foreground.id < 0)
 		m_overCells.back().cell.colors.foreground = 0;
 
-	if (m_do.updateAutomatically)
-		priv_updateOverCells();
+	m_isStackUpdateRequired = true;
 }
 
 void ConsoleScreen::addUnderAt(const Location& location, const char character, const sf::Vector2f offset)
@@ -1097,8 +1296,7 @@ void ConsoleScreen::addUnderAt(const Location& location, const Cell& cell, const
 	if (m_underCells.back().cell.colors.foreground.id < 0)
 		m_underCells.back().cell.colors.foreground = 0;
 
-	if (m_do.updateAutomatically)
-		priv_updateUnderCells();
+	m_isStackUpdateRequired = true;
 }
 
 void ConsoleScreen::clearOversAt(const Location& location)
@@ -1106,8 +1304,7 @@ void ConsoleScreen::clearOversAt(const Location& location)
 	const unsigned int index{ priv_cellIndex(location) };
 	m_overCells.erase(std::remove_if(m_overCells.begin(), m_overCells.end(), [&index](const StackCell& stackCell) { return stackCell.index == index; }), m_overCells.end());
 
-	if (m_do.updateAutomatically)
-		priv_updateOverCells();
+	m_isStackUpdateRequired = true;
 }
 
 void ConsoleScreen::clearUndersAt(const Location& location)
@@ -1115,8 +1312,7 @@ void ConsoleScreen::clearUndersAt(const Location& location)
 	const unsigned int index{ priv_cellIndex(location) };
 	m_underCells.erase(std::remove_if(m_underCells.begin(), m_underCells.end(), [&index](const StackCell& stackCell) { return stackCell.index == index; }), m_underCells.end());
 
-	if (m_do.updateAutomatically)
-		priv_updateUnderCells();
+	m_isStackUpdateRequired = true;
 }
 
 void ConsoleScreen::clearStackAt(const Location& location)
@@ -1129,16 +1325,14 @@ void ConsoleScreen::clearOvers()
 {
 	m_overCells.clear();
 
-	if (m_do.updateAutomatically)
-		m_overDisplay.clear();
+	m_isStackUpdateRequired = true;
 }
 
 void ConsoleScreen::clearUnders()
 {
 	m_underCells.clear();
 
-	if (m_do.updateAutomatically)
-		m_underDisplay.clear();
+	m_isStackUpdateRequired = true;
 }
 
 void ConsoleScreen::clearStack()
@@ -1189,11 +1383,8 @@ void ConsoleScreen::pasteOver(const unsigned int index, const sf::Vector2i offse
 			continue;
 		const sf::Vector2u cellLocation{ static_cast<unsigned int>(location.x), static_cast<unsigned int>(location.y) };
 		if (priv_isCellLocationInRange(cellLocation))
-			addOverAt(cellLocation, buffer.cells[i]);
+			addOverAt(cellLocation, buffer.cells.get(i));
 	}
-
-	if (m_do.updateAutomatically)
-		update();
 }
 
 void ConsoleScreen::pasteUnder(const unsigned int index, const sf::Vector2i offset)
@@ -1214,11 +1405,8 @@ void ConsoleScreen::pasteUnder(const unsigned int index, const sf::Vector2i offs
 			continue;
 		const sf::Vector2u cellLocation{ static_cast<unsigned int>(location.x), static_cast<unsigned int>(location.y) };
 		if (priv_isCellLocationInRange(cellLocation))
-			addUnderAt(cellLocation, buffer.cells[i]);
+			addUnderAt(cellLocation, buffer.cells.get(i));
 	}
-
-	if (m_do.updateAutomatically)
-		update();
 }
 
 unsigned int ConsoleScreen::getCellAttributesBitmask(const PrintType printType)
@@ -1239,8 +1427,7 @@ void ConsoleScreen::clearCellAt(const sf::Vector2u location)
 
 	priv_clearCell(priv_cellIndex(location), m_cursorPrintProperties.colors.foreground, m_cursorPrintProperties.colors.background);
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(priv_cellIndex(location));
+	priv_markCellForUpdate(priv_cellIndex(location));
 }
 
 void ConsoleScreen::setCellAt(const sf::Vector2u location, const Cell& cell)
@@ -1252,10 +1439,9 @@ void ConsoleScreen::setCellAt(const sf::Vector2u location, const Cell& cell)
 		return;
 	}
 
-	m_cells[priv_cellIndex(location)] = cell;
+	m_cells.set(priv_storageIndex(location), cell);
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(priv_cellIndex(location));
+	priv_markCellForUpdate(priv_cellIndex(location));
 }
 
 void ConsoleScreen::setValueAt(const sf::Vector2u location, const unsigned int value)
@@ -1267,10 +1453,9 @@ void ConsoleScreen::setValueAt(const sf::Vector2u location, const unsigned int v
 		return;
 	}
 
-	m_cells[priv_cellIndex(location)].value = value;
+	m_cells.edit(priv_storageIndex(location)).value = value;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(priv_cellIndex(location));
+	priv_markCellForUpdate(priv_cellIndex(location));
 }
 
 void ConsoleScreen::setColorsAt(const sf::Vector2u location, const Color color, const Color backgroundColor)
@@ -1283,11 +1468,10 @@ void ConsoleScreen::setColorsAt(const sf::Vector2u location, const Color color,
 	}
 
 	const unsigned int index{ priv_cellIndex(location) };
-	m_cells[index].colors.foreground = color;
-	m_cells[index].colors.background = backgroundColor;
+	m_cells.edit(priv_storageIndex(index)).colors.foreground = color;
+	m_cells.edit(priv_storageIndex(index)).colors.background = backgroundColor;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+	priv_markCellForUpdate(index);
 
 }
 
@@ -1301,10 +1485,9 @@ void ConsoleScreen::setForegroundColorAt(const sf::Vector2u location, const Colo
 	}
 
 	const unsigned int index{ priv_cellIndex(location) };
-	m_cells[index].colors.foreground = color;
+	m_cells.edit(priv_storageIndex(index)).colors.foreground = color;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+	priv_markCellForUpdate(index);
 }
 
 void ConsoleScreen::setBackgroundColorAt(const sf::Vector2u location, const Color backgroundColor)
@@ -1317,10 +1500,9 @@ void ConsoleScreen::setBackgroundColorAt(const sf::Vector2u location, const Colo
 	}
 
 	const unsigned int index{ priv_cellIndex(location) };
-	m_cells[index].colors.background = backgroundColor;
+	m_cells.edit(priv_storageIndex(index)).colors.background = backgroundColor;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+	priv_markCellForUpdate(index);
 }
 
 void ConsoleScreen::setStretchAt(const sf::Vector2u location, const StretchType& stretch)
@@ -1332,10 +1514,9 @@ void ConsoleScreen::setStretchAt(const sf::Vector2u location, const StretchType&
 		return;
 	}
 
-	m_cells[priv_cellIndex(location)].stretch = stretch;
+	m_cells.edit(priv_storageIndex(location)).stretch = stretch;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(priv_cellIndex(location));
+	priv_markCellForUpdate(priv_cellIndex(location));
 }
 
 void ConsoleScreen::setAttributesAt(const sf::Vector2u location, const CellAttributes& attributes)
@@ -1347,10 +1528,9 @@ void ConsoleScreen::setAttributesAt(const sf::Vector2u location, const CellAttri
 		return;
 	}
 
-	m_cells[priv_cellIndex(location)].attributes = attributes;
+	m_cells.edit(priv_storageIndex(location)).attributes = attributes;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(priv_cellIndex(location));
+	priv_markCellForUpdate(priv_cellIndex(location));
 }
 
 void ConsoleScreen::setAttributesAt(const sf::Vector2u location, const Affect& attributeMask)
@@ -1362,14 +1542,13 @@ void ConsoleScreen::setAttributesAt(const sf::Vector2u location, const Affect& a
 		return;
 	}
 
-	CellAttributes& cellAttributes{ m_cells[priv_cellIndex(location)].attributes };
+	CellAttributes& cellAttributes{ m_cells.edit(priv_storageIndex(location)).attributes };
 	cellAttributes.inverse = (attributeMask & Affect::Inverse) == Affect::Inverse;
 	cellAttributes.dark = (attributeMask & Affect::Dark) == Affect::Dark;
 	cellAttributes.flipX = (attributeMask & Affect::FlipX) == Affect::FlipX;
 	cellAttributes.flipY = (attributeMask & Affect::FlipY) == Affect::FlipY;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(priv_cellIndex(location));
+	priv_markCellForUpdate(priv_cellIndex(location));
 }
 
 void ConsoleScreen::setAttributesToAt(const sf::Vector2u location, const bool attributeValue, const Affect& attributeMask)
@@ -1381,7 +1560,7 @@ void ConsoleScreen::setAttributesToAt(const sf::Vector2u location, const bool at
 		return;
 	}
 
-	CellAttributes& cellAttributes{ m_cells[priv_cellIndex(location)].attributes };
+	CellAttributes& cellAttributes{ m_cells.edit(priv_storageIndex(location)).attributes };
 	if ((attributeMask & Affect::Inverse) == Affect::Inverse)
 		cellAttributes.inverse = attributeValue;
 	if ((attributeMask & Affect::Dark) == Affect::Dark)
@@ -1391,8 +1570,7 @@ void ConsoleScreen::setAttributesToAt(const sf::Vector2u location, const bool at
 	if ((attributeMask & Affect::FlipY) == Affect::FlipY)
 		cellAttributes.flipY = attributeValue;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(priv_cellIndex(location));
+	priv_markCellForUpdate(priv_cellIndex(location));
 }
 
 ConsoleScreen::Cell ConsoleScreen::getCellAt(const sf::Vector2u location) const
@@ -1404,7 +1582,7 @@ ConsoleScreen::Cell ConsoleScreen::getCellAt(const sf::Vector2u location) const
 		return Cell();
 	}
 
-	return m_cells[priv_cellIndex(location)];
+	return m_cells.get(priv_storageIndex(location));
 }
 
 unsigned int ConsoleScreen::getValueAt(const sf::Vector2u location) const
@@ -1416,7 +1594,7 @@ unsigned int ConsoleScreen::getValueAt(const sf::Vector2u location) const
 		return 0u;
 	}
 
-	return m_cells[priv_cellIndex(location)].value;
+	return m_cells.get(priv_storageIndex(location)).value;
 }
 
 ConsoleScreen::Color ConsoleScreen::getColorAt(const sf::Vector2u location) const
@@ -1428,7 +1606,7 @@ ConsoleScreen::Color ConsoleScreen::getColorAt(const sf::Vector2u location) cons
 		return Color(ColorCommand::Unused);
 	}
 
-	return m_cells[priv_cellIndex(location)].colors.foreground;
+	return m_cells.get(priv_storageIndex(location)).colors.foreground;
 }
 
 ConsoleScreen::Color ConsoleScreen::getBackgroundColorAt(const sf::Vector2u location) const
@@ -1440,7 +1618,7 @@ ConsoleScreen::Color ConsoleScreen::getBackgroundColorAt(const sf::Vector2u loca
 		return Color(ColorCommand::Unused);
 	}
 
-	return m_cells[priv_cellIndex(location)].colors.background;
+	return m_cells.get(priv_storageIndex(location)).colors.background;
 }
 
 ConsoleScreen::StretchType ConsoleScreen::getStretchAt(const sf::Vector2u location) const
@@ -1452,7 +1630,7 @@ ConsoleScreen::StretchType ConsoleScreen::getStretchAt(const sf::Vector2u locati
 		return StretchType::None;
 	}
 
-	return m_cells[priv_cellIndex(location)].stretch;
+	return m_cells.get(priv_storageIndex(location)).stretch;
 }
 
 ConsoleScreen::CellAttributes ConsoleScreen::getAttributesAt(const sf::Vector2u location) const
@@ -1464,7 +1642,7 @@ ConsoleScreen::CellAttributes ConsoleScreen::getAttributesAt(const sf::Vector2u
 		return CellAttributes();
 	}
 
-	return m_cells[priv_cellIndex(location)].attributes;
+	return m_cells.get(priv_storageIndex(location)).attributes;
 }
 
 bool ConsoleScreen::getAttributeAt(const sf::Vector2u location, const Affect& attributeMask)
@@ -1476,7 +1654,7 @@ bool ConsoleScreen::getAttributeAt(const sf::Vector2u location, const Affect& at
 		return false;
 	}
 
-	CellAttributes& cellAttributes{ m_cells[priv_cellIndex(location)].attributes };
+	const CellAttributes cellAttributes{ m_cells.get(priv_storageIndex(location)).attributes };
 	if ((attributeMask & Affect::Inverse) == Affect::Inverse)
 		return cellAttributes.inverse;
 	if ((attributeMask & Affect::Dark) == Affect::Dark)
@@ -1496,6 +1674,20 @@ void ConsoleScreen::scrollUp(const unsigned int amount)
 	if (m_mode.y == 0 || amount == 0)
 		return;
 
+	if (m_do.useRowRingBuffer)
+	{
+		priv_offsetRows(static_cast<int>(amount % m_mode.y));
+		if (!m_do.wrapOnManualScroll)
+		{
+			for (unsigned int y{ (amount < m_mode.y) ? m_mode.y - amount : 0u }; y < m_mode.y; ++y)
+			{
+				for (unsigned int x{ 0 }; x < m_mode.x; ++x)
+					priv_clearCell(priv_cellIndex({ x, y }), true, true);
+			}
+		}
+		return;
+	}
+
 	std::vector<Cell> topRow(m_mode.x);
 	for (unsigned int repeat{ 0 }; repeat < amount; ++repeat) // lazy way of scrolling multiple times - loop scrolling (entirely by 1 each time)
 	{
@@ -1504,19 +1696,18 @@ void ConsoleScreen::scrollUp(const unsigned int amount)
 			for (unsigned int x{ 0 }; x < m_mode.x; ++x)
 			{
 				if (m_do.wrapOnManualScroll && y == 0)
-					topRow[x] = m_cells[x];
+					topRow[x] = m_cells.get(priv_storageIndex(x));
 				if (y < m_mode.y - 1)
-					m_cells[priv_cellIndex({ x, y })] = m_cells[priv_cellIndex({ x, y + 1 })];
+					m_cells.copy(priv_storageIndex({ x, y }), priv_storageIndex({ x, y + 1 }));
 				else if (m_do.wrapOnManualScroll)
-					m_cells[priv_cellIndex({ x, y })] = topRow[x];
+					m_cells.set(priv_storageIndex({ x, y }), topRow[x]);
 				else
 					priv_clearCell(priv_cellIndex({ x, y }), true, true);
 			}
 		}
 	}
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::scrollDown(const unsigned int amount)
@@ -1524,6 +1715,20 @@ void ConsoleScreen::scrollDown(const unsigned int amount)
 	if (m_mode.y == 0 || amount == 0)
 		return;
 
+	if (m_do.useRowRingBuffer)
+	{
+		priv_offsetRows(-static_cast<int>(amount % m_mode.y));
+		if (!m_do.wrapOnManualScroll)
+		{
+			for (unsigned int y{ 0 }; y < amount && y < m_mode.y; ++y)
+			{
+				for (unsigned int x{ 0 }; x < m_mode.x; ++x)
+					priv_clearCell(priv_cellIndex({ x, y }), true, true);
+			}
+		}
+		return;
+	}
+
 	std::vector<Cell> bottomRow(m_mode.x);
 	for (unsigned int repeat{ 0 }; repeat < amount; ++repeat) // lazy way of scrolling multiple times - loop scrolling (entirely by 1 each time)
 	{
@@ -1533,19 +1738,18 @@ void ConsoleScreen::scrollDown(const unsigned int amount)
 			{
 				const unsigned cellY{ m_mode.y - y - 1 };
 				if (m_do.wrapOnManualScroll && y == 0)
-					bottomRow[x] = m_cells[priv_cellIndex({ x, cellY })];
+					bottomRow[x] = m_cells.get(priv_storageIndex({ x, cellY }));
 				if (cellY > 0)
-					m_cells[priv_cellIndex({ x, cellY })] = m_cells[priv_cellIndex({ x, cellY - 1 })];
+					m_cells.copy(priv_storageIndex({ x, cellY }), priv_storageIndex({ x, cellY - 1 }));
 				else if (m_do.wrapOnManualScroll)
-					m_cells[priv_cellIndex({ x, cellY })] = bottomRow[x];
+					m_cells.set(priv_storageIndex({ x, cellY }), bottomRow[x]);
 				else
 					priv_clearCell(priv_cellIndex({ x, cellY }), true, true);
 			}
 		}
 	}
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::scrollLeft(const unsigned int amount)
@@ -1559,21 +1763,20 @@ void ConsoleScreen::scrollLeft(const unsigned int amount)
 		for (unsigned int cell{ 0 }; cell < m_cells.size(); ++cell)
 		{
 			if (cell % m_mode.x == 0)
-				leftCell = m_cells[cell];
+				leftCell = m_cells.get(priv_storageIndex(cell));
 			if (cell % m_mode.x == m_mode.x - 1)
 			{
 				if (m_do.wrapOnManualScroll)
-					m_cells[cell] = leftCell;
+					m_cells.set(priv_storageIndex(cell), leftCell);
 				else
 					priv_clearCell(cell, true, true);
 			}
 			else
-				m_cells[cell] = m_cells[cell + 1];
+				m_cells.copy(priv_storageIndex(cell), priv_storageIndex(cell + 1));
 		}
 	}
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::scrollRight(const unsigned int amount)
@@ -1588,21 +1791,20 @@ void ConsoleScreen::scrollRight(const unsigned int amount)
 		{
 			const unsigned int cell{ static_cast<unsigned int>(m_cells.size()) - i - 1 };
 			if (i % m_mode.x == 0)
-				rightCell = m_cells[cell];
+				rightCell = m_cells.get(priv_storageIndex(cell));
 			if (cell % m_mode.x == 0)
 			{
 				if (m_do.wrapOnManualScroll)
-					m_cells[cell] = rightCell;
+					m_cells.set(priv_storageIndex(cell), rightCell);
 				else
 					priv_clearCell(cell, true, true);
 			}
 			else
-				m_cells[cell] = m_cells[cell - 1];
+				m_cells.copy(priv_storageIndex(cell), priv_storageIndex(cell - 1));
 		}
 	}
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::scrollUp(unsigned int amount, sf::IntRect selectionRectangle)
@@ -1625,19 +1827,18 @@ void ConsoleScreen::scrollUp(unsigned int amount, sf::IntRect selectionRectangle
 			for (unsigned int x{ 0 }; x < static_cast<unsigned int>(selectionRectangle.size.x); ++x)
 			{
 				if (m_do.wrapOnManualScroll && y == 0)
-					topRow[x] = m_cells[priv_cellIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y })];
+					topRow[x] = m_cells.get(priv_storageIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y }));
 				if (y < static_cast<unsigned int>(selectionRectangle.size.y) - 1)
-					m_cells[priv_cellIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y })] = m_cells[priv_cellIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y + 1 })];
+					m_cells.copy(priv_storageIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y }), priv_storageIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y + 1 }));
 				else if (m_do.wrapOnManualScroll)
-					m_cells[priv_cellIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y })] = topRow[x];
+					m_cells.set(priv_storageIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y }), topRow[x]);
 				else
 					priv_clearCell(priv_cellIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y }), true, true);
 			}
 		}
 	}
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markSelectionRectangleForUpdate(selectionRectangle);
 }
 
 void ConsoleScreen::scrollDown(unsigned int amount, sf::IntRect selectionRectangle)
@@ -1661,19 +1862,18 @@ void ConsoleScreen::scrollDown(unsigned int amount, sf::IntRect selectionRectang
 			{
 				const unsigned cellY{ selectionRectangle.position.x + selectionRectangle.size.y - y - 1 };
 				if (m_do.wrapOnManualScroll && y == 0)
-					bottomRow[x] = m_cells[priv_cellIndex({ selectionRectangle.position.x + x, cellY })];
+					bottomRow[x] = m_cells.get(priv_storageIndex({ selectionRectangle.position.x + x, cellY }));
 				if (cellY > static_cast<unsigned int>(selectionRectangle.position.y))
-					m_cells[priv_cellIndex({ selectionRectangle.position.x + x, cellY })] = m_cells[priv_cellIndex({ selectionRectangle.position.x + x, cellY - 1 })];
+					m_cells.copy(priv_storageIndex({ selectionRectangle.position.x + x, cellY }), priv_storageIndex({ selectionRectangle.position.x + x, cellY - 1 }));
 				else if (m_do.wrapOnManualScroll)
-					m_cells[priv_cellIndex({ selectionRectangle.position.x + x, cellY })] = bottomRow[x];
+					m_cells.set(priv_storageIndex({ selectionRectangle.position.x + x, cellY }), bottomRow[x]);
 				else
 					priv_clearCell(priv_cellIndex({ selectionRectangle.position.x + x, cellY }), true, true);
 			}
 		}
 	}
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markSelectionRectangleForUpdate(selectionRectangle);
 }
 
 void ConsoleScreen::scrollLeft(unsigned int amount, sf::IntRect selectionRectangle)
@@ -1696,19 +1896,18 @@ void ConsoleScreen::scrollLeft(unsigned int amount, sf::IntRect selectionRectang
 			for (unsigned int y{ 0 }; y < static_cast<unsigned int>(selectionRectangle.size.y); ++y)
 			{
 				if (m_do.wrapOnManualScroll && x == 0)
-					leftColumn[y] = m_cells[priv_cellIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y })];
+					leftColumn[y] = m_cells.get(priv_storageIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y }));
 				if (x < static_cast<unsigned int>(selectionRectangle.size.x) - 1)
-					m_cells[priv_cellIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y })] = m_cells[priv_cellIndex({ selectionRectangle.position.x + x + 1, selectionRectangle.position.y + y })];
+					m_cells.copy(priv_storageIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y }), priv_storageIndex({ selectionRectangle.position.x + x + 1, selectionRectangle.position.y + y }));
 				else if (m_do.wrapOnManualScroll)
-					m_cells[priv_cellIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y})] = leftColumn[y];
+					m_cells.set(priv_storageIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y}), leftColumn[y]);
 				else
 					priv_clearCell(priv_cellIndex({ selectionRectangle.position.x + x, selectionRectangle.position.y + y }), true, true);
 			}
 		}
 	}
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markSelectionRectangleForUpdate(selectionRectangle);
 }
 
 void ConsoleScreen::scrollRight(unsigned int amount, sf::IntRect selectionRectangle)
@@ -1732,19 +1931,18 @@ void ConsoleScreen::scrollRight(unsigned int amount, sf::IntRect selectionRectan
 			{
 				const unsigned cellX{ selectionRectangle.position.x + selectionRectangle.size.x - x - 1 };
 				if (m_do.wrapOnManualScroll && x == 0)
-					rightColumn[y] = m_cells[priv_cellIndex({ cellX, selectionRectangle.position.y + y, })];
+					rightColumn[y] = m_cells.get(priv_storageIndex({ cellX, selectionRectangle.position.y + y, }));
 				if (cellX > static_cast<unsigned int>(selectionRectangle.position.x))
-					m_cells[priv_cellIndex({ cellX, selectionRectangle.position.y + y })] = m_cells[priv_cellIndex({ cellX - 1, selectionRectangle.position.y + y })];
+					m_cells.copy(priv_storageIndex({ cellX, selectionRectangle.position.y + y }), priv_storageIndex({ cellX - 1, selectionRectangle.position.y + y }));
 				else if (m_do.wrapOnManualScroll)
-					m_cells[priv_cellIndex({ cellX, selectionRectangle.position.y + y })] = rightColumn[y];
+					m_cells.set(priv_storageIndex({ cellX, selectionRectangle.position.y + y }), rightColumn[y]);
 				else
 					priv_clearCell(priv_cellIndex({ cellX, selectionRectangle.position.y + y }), true, true);
 			}
 		}
 	}
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markSelectionRectangleForUpdate(selectionRectangle);
 }
 
 void ConsoleScreen::fill(Cell cell)
@@ -1761,11 +1959,10 @@ void ConsoleScreen::fill(Cell cell)
 	if (cell.colors.foreground.id < 0)
 		cell.colors.foreground = 0;
 
-	for (auto& singleCell : m_cells)
-		singleCell = cell;
+	for (unsigned int i{ 0 }; i < m_cells.size(); ++i)
+		m_cells.set(i, cell);
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::clear(const ColorPair colors)
@@ -1781,8 +1978,7 @@ void ConsoleScreen::clear(const ColorPair colors)
 		priv_clearCell(i, colors.foreground, colors.background);
 	m_cursorPrintProperties.index = 0u;
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::clear(const Color backgroundColor)
@@ -1802,14 +1998,18 @@ void ConsoleScreen::clear()
 
 void ConsoleScreen::crash()
 {
-	for (auto& cell : m_cells)
+	for (unsigned int i{ 0 }; i < m_cells.size(); ++i)
 	{
-		cell = { randomByte(), ColorPair(priv_getRandomColor(), priv_getRandomColor()) };
+		m_cells.set(i, { m_random.getInteger(255u), ColorPair(priv_getRandomColor(), priv_getRandomColor()) });
 	}
 	m_cursorPrintProperties.index = static_cast<unsigned int>(m_cells.size()) - 1u;
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markAllCellsForUpdate();
+}
+
+void ConsoleScreen::setSeed(const std::uint64_t seed)
+{
+	m_random.setSeed(seed);
 }
 
 std::string ConsoleScreen::read()
@@ -1840,6 +2040,72 @@ std::string ConsoleScreen::read(const Location& location, const unsigned int len
 	return read(location);
 }
 
+void ConsoleScreen::read(std::string& string)
+{
+	*this >> string;
+}
+
+void ConsoleScreen::read(const Location& location, std::string& string)
+{
+	PrintProperties backupPrintProperties = priv_getCurrentPrintProperties();
+	*this >> location >> string;
+	priv_getCurrentPrintProperties() = backupPrintProperties;
+}
+
+std::size_t ConsoleScreen::read(char* const characters, const std::size_t size)
+{
+	return priv_read(priv_getCurrentPrintProperties().index, characters, size);
+}
+
+std::size_t ConsoleScreen::read(const Location& location, char* const characters, const std::size_t size)
+{
+	PrintProperties backupPrintProperties = priv_getCurrentPrintProperties();
+	*this >> location;
+	const std::size_t numberOfCharacters{ priv_read(priv_getCurrentPrintProperties().index, characters, size) };
+	priv_getCurrentPrintProperties() = backupPrintProperties;
+	return numberOfCharacters;
+}
+
+sf::Vector2u ConsoleScreen::exportValues(std::vector<std::uint32_t>& values) const
+{
+	return exportValues(values, { { 0, 0 }, sf::Vector2i(m_mode) });
+}
+
+sf::Vector2u ConsoleScreen::exportValues(std::vector<std::uint32_t>& values, const sf::IntRect selectionRectangle) const
+{
+	const sf::IntRect rectangle{ priv_getSelectionRectangleClippedToScreen(selectionRectangle) };
+	const sf::Vector2u size(rectangle.size);
+	values.resize(static_cast<std::size_t>(size.x) * size.y);
+	std::uint32_t* value{ values.data() };
+	for (unsigned int y{ 0u }; y < size.y; ++y)
+	{
+		const unsigned int rowStorageIndex{ priv_storageIndex(sf::Vector2u(rectangle.position) + sf::Vector2u{ 0u, y }) }; // a row is contiguous in storage
+		for (unsigned int x{ 0u }; x < size.x; ++x)
+			*value++ = static_cast<std::uint32_t>(m_cells.get(rowStorageIndex + x).value);
+	}
+	return size;
+}
+
+sf::Vector2u ConsoleScreen::exportColors(std::vector<ColorPair>& colors) const
+{
+	return exportColors(colors, { { 0, 0 }, sf::Vector2i(m_mode) });
+}
+
+sf::Vector2u ConsoleScreen::exportColors(std::vector<ColorPair>& colors, const sf::IntRect selectionRectangle) const
+{
+	const sf::IntRect rectangle{ priv_getSelectionRectangleClippedToScreen(selectionRectangle) };
+	const sf::Vector2u size(rectangle.size);
+	colors.resize(static_cast<std::size_t>(size.x) * size.y);
+	ColorPair* color{ colors.data() };
+	for (unsigned int y{ 0u }; y < size.y; ++y)
+	{
+		const unsigned int rowStorageIndex{ priv_storageIndex(sf::Vector2u(rectangle.position) + sf::Vector2u{ 0u, y }) };
+		for (unsigned int x{ 0u }; x < size.x; ++x)
+			*color++ = m_cells.get(rowStorageIndex + x).colors;
+	}
+	return size;
+}
+
 void ConsoleScreen::loadPalette(const Palette palette)
 {
 	m_is.rgbMode = false;
@@ -1901,8 +2167,8 @@ void ConsoleScreen::loadPalette(const Palette palette)
 	default:
 		addPaletteDefault(m_palette);
 	}
-	if (m_do.updateAutomatically)
-		update();
+	m_isPaletteLookupValid = false;
+	priv_markAllCellsForUpdate();
 }
 
 void ConsoleScreen::setPaletteColor(const Color color, const sf::Color newColor)
@@ -1921,9 +2187,26 @@ void ConsoleScreen::setPaletteColor(const Color color, const sf::Color newColor)
 	}
 
 	m_palette[color.id] = newColor;
+	m_isPaletteLookupValid = false;
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markCellsUsingPaletteRangeForUpdate(color.id, color.id);
+}
+
+ConsoleScreen::Color ConsoleScreen::getClosestPaletteColor(const sf::Color color) const
+{
+	if (m_is.rgbMode)
+		return Color(color.r * 65536L + color.g * 256L + color.b);
+
+	const int index{ priv_getIndexOfClosestPaletteColor(color) };
+	return Color((index < 0) ? 0 : index);
+}
+
+std::vector<ConsoleScreen::Color> ConsoleScreen::getClosestPaletteColors(const std::vector<sf::Color>& colors) const
+{
+	std::vector<Color> closestColors(colors.size());
+	for (std::size_t i{ 0u }; i < colors.size(); ++i)
+		closestColors[i] = getClosestPaletteColor(colors[i]);
+	return closestColors;
 }
 
 sf::Color ConsoleScreen::getPaletteColor(const Color color) const
@@ -1953,7 +2236,11 @@ void ConsoleScreen::setPaletteSize(const unsigned long int size)
 		return;
 	}
 
+	const unsigned long int previousSize{ static_cast<unsigned long int>(m_palette.size()) };
 	m_palette.resize(size);
+	m_isPaletteLookupValid = false;
+
+	priv_markCellsUsingPaletteRangeForUpdate(static_cast<long int>(std::min(previousSize, size)), std::numeric_limits<long int>::max());
 }
 
 void ConsoleScreen::removePaletteColor(const Color color)
@@ -1978,6 +2265,9 @@ void ConsoleScreen::removePaletteColor(const Color color)
 	}
 
 	m_palette.erase(m_palette.begin() + color.id);
+	m_isPaletteLookupValid = false;
+
+	priv_markCellsUsingPaletteRangeForUpdate(color.id, std::numeric_limits<long int>::max());
 }
 
 void ConsoleScreen::cyclePaletteUp(const long int amount)
@@ -2022,9 +2312,9 @@ void ConsoleScreen::cyclePaletteUp(Color firstColor, Color lastColor, long int a
 		else
 			m_palette[i] = buffer[firstColor.id - (i - amount) - 1];
 	}
+	m_isPaletteLookupValid = false;
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markCellsUsingPaletteRangeForUpdate(firstColor.id, lastColor.id);
 }
 
 void ConsoleScreen::cyclePaletteDown(Color firstColor, Color lastColor, long int amount)
@@ -2053,14 +2343,14 @@ void ConsoleScreen::cyclePaletteDown(Color firstColor, Color lastColor, long int
 		else
 			m_palette[i] = buffer[i + amount - lastColor.id - 1];
 	}
+	m_isPaletteLookupValid = false;
 
-	if (m_do.updateAutomatically)
-		update();
+	priv_markCellsUsingPaletteRangeForUpdate(firstColor.id, lastColor.id);
 }
 
 unsigned int ConsoleScreen::copy()
 {
-	m_buffers.push_back({ m_mode.x, m_cells });
+	m_buffers.push_back({ m_mode.x, priv_getCellsInScreenOrder() });
 	return static_cast<unsigned int>(m_buffers.size()) - 1u;
 }
 
@@ -2073,15 +2363,12 @@ void ConsoleScreen::copy(const unsigned int index)
 		return;
 	}
 
-	m_buffers[index] = { m_mode.x, m_cells };
-
-	if (m_do.updateAutomatically)
-		update();
+	m_buffers[index] = { m_mode.x, priv_getCellsInScreenOrder() };
 }
 
 unsigned int ConsoleScreen::copy(const sf::IntRect selectionRectangle)
 {
-	m_buffers.emplace_back();
+	m_buffers.push_back({ 0u, CellStorage(m_do.usePackedCells) });
 	priv_copyToBufferFromSelectionRectangle(m_buffers.back(), selectionRectangle);
 	return static_cast<unsigned int>(m_buffers.size()) - 1u;
 }
@@ -2149,7 +2436,7 @@ void ConsoleScreen::removeBuffer(const unsigned int index)
 unsigned int ConsoleScreen::addBuffer(const sf::Vector2u size)
 {
 	const unsigned int newBufferIndex{ static_cast<unsigned int>(m_buffers.size()) };
-	m_buffers.emplace_back();
+	m_buffers.push_back({ 0u, CellStorage(m_do.usePackedCells) });
 	resizeBuffer(static_cast<unsigned int>(m_buffers.size()) - 1u, size);
 	return newBufferIndex;
 }
@@ -2181,7 +2468,7 @@ void ConsoleScreen::resizeBuffer(const unsigned int index, const sf::Vector2u si
 		for (unsigned int i{ 0u }; i < size.x * currentBufferHeight; ++i)
 		{
 			const unsigned int targetIndex{ (i / size.x) * buffer.width + (i % size.x) };
-			buffer.cells[i] = buffer.cells[targetIndex];
+			buffer.cells.copy(i, targetIndex);
 		}
 
 		buffer.cells.resize(size.x * currentBufferHeight);
@@ -2194,11 +2481,11 @@ void ConsoleScreen::resizeBuffer(const unsigned int index, const sf::Vector2u si
 		{
 			if (i % size.x >= buffer.width)
 			{
-				buffer.cells[i] = defaultCell;
+				buffer.cells.set(i, defaultCell);
 				continue;
 			}
 			const unsigned int targetIndex{ (i / size.x) * buffer.width + (i % size.x) };
-			buffer.cells[i] = buffer.cells[targetIndex];
+			buffer.cells.copy(i, targetIndex);
 		}
 
 		buffer.width = size.x;
@@ -2209,7 +2496,7 @@ void ConsoleScreen::resizeBuffer(const unsigned int index, const sf::Vector2u si
 		for (unsigned int i{ 0u }; i < newNumberOfCells; ++i)
 		{
 			const unsigned int targetIndex{ (i / size.x) * buffer.width + (i % size.x) };
-			buffer.cells[i] = buffer.cells[targetIndex];
+			buffer.cells.copy(i, targetIndex);
 		}
 
 		buffer.cells.resize(newNumberOfCells);
@@ -2221,11 +2508,11 @@ void ConsoleScreen::resizeBuffer(const unsigned int index, const sf::Vector2u si
 		{
 			if (i / size.x >= currentBufferHeight)
 			{
-				buffer.cells[i] = defaultCell;
+				buffer.cells.set(i, defaultCell);
 				continue;
 			}
 			const unsigned int targetIndex{ (i / size.x) * buffer.width + (i % size.x) };
-			buffer.cells[i] = buffer.cells[targetIndex];
+			buffer.cells.copy(i, targetIndex);
 		}
 	}
 }
@@ -2243,22 +2530,92 @@ sf::Vector2u ConsoleScreen::getSizeOfBuffer(const unsigned int index) const
 	return sf::Vector2u(static_cast<unsigned int>(buffer.cells.size()) % buffer.width, static_cast<unsigned int>(buffer.cells.size()) / buffer.width);
 }
 
-void ConsoleScreen::poke(const unsigned int index, const Cell& cell)
+void ConsoleScreen::setScrollbackSize(const unsigned int maximumNumberOfRows)
 {
-	if (!priv_isCellIndexInRange(index))
+	// rows are kept in order (oldest first) from the beginning of storage after resizing
+	const unsigned int numberOfRowsKept{ std::min(m_numberOfScrollbackRows, maximumNumberOfRows) };
+	const unsigned int numberOfStorageRows{ (m_mode.x > 0u) ? static_cast<unsigned int>(m_scrollbackCells.size() / m_mode.x) : 0u };
+	CellStorage scrollbackCells(true);
+	for (unsigned int row{ m_numberOfScrollbackRows - numberOfRowsKept }; row < m_numberOfScrollbackRows; ++row)
 	{
-		if (m_do.throwExceptions)
-			throw Exception(exceptionPrefix + "Cannot poke cell.\nCell number (" + std::to_string(index) + ") out of range.");
-		return;
+		const unsigned int storageRowStartIndex{ ((m_scrollbackFirstRow + row) % numberOfStorageRows) * m_mode.x };
+		for (unsigned int x{ 0u }; x < m_mode.x; ++x)
+			scrollbackCells.pushBack(m_scrollbackCells.get(storageRowStartIndex + x));
 	}
+	m_scrollbackCells = std::move(scrollbackCells);
+	m_scrollbackSize = maximumNumberOfRows;
+	m_scrollbackFirstRow = 0u;
+	m_numberOfScrollbackRows = numberOfRowsKept;
+	m_scrollbackViewOffset = std::min(m_scrollbackViewOffset, m_numberOfScrollbackRows);
+}
 
-	m_cells[index] = cell;
-
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+void ConsoleScreen::clearScrollback()
+{
+	m_scrollbackCells.clear();
+	m_scrollbackFirstRow = 0u;
+	m_numberOfScrollbackRows = 0u;
+	m_numberOfRowsAddedToScrollback = 0u;
+	m_scrollbackViewOffset = 0u;
+	priv_invalidateScrollbackDisplay();
 }
 
-void ConsoleScreen::poke(const unsigned int index, const unsigned int value)
+void ConsoleScreen::setScrollbackViewOffset(const unsigned int numberOfRows)
+{
+	// moving the view only requires the newly exposed scrollback rows to be updated (the screen's vertices are reused)
+	m_scrollbackViewOffset = std::min(numberOfRows, m_numberOfScrollbackRows);
+}
+
+void ConsoleScreen::setMappedCharacter(const char character, const unsigned int value)
+{
+	removeMappedCharacter(character);
+	const unsigned char characterIndex{ static_cast<unsigned char>(character) };
+	m_characterMap[characterIndex] = value;
+	m_isCharacterMapped[characterIndex] = true;
+	if (value > maximumReverseCharacterMapValue)
+		return;
+	if (value >= m_characterMapReverse.size())
+		m_characterMapReverse.resize(value + 1u, noReverseCharacter);
+	m_characterMapReverse[value] = characterIndex; // the most recently mapped character is used when reading a value shared by multiple characters
+}
+
+void ConsoleScreen::removeMappedCharacter(const char character)
+{
+	const unsigned char characterIndex{ static_cast<unsigned char>(character) };
+	if (!m_isCharacterMapped[characterIndex])
+		return;
+	const unsigned int value{ m_characterMap[characterIndex] };
+	m_characterMap[characterIndex] = characterIndex;
+	m_isCharacterMapped[characterIndex] = false;
+	if ((value >= m_characterMapReverse.size()) || (m_characterMapReverse[value] != characterIndex))
+		return;
+
+	// another character may still be mapped to the same value
+	m_characterMapReverse[value] = noReverseCharacter;
+	for (unsigned int i{ 0u }; i < m_characterMap.size(); ++i)
+	{
+		if (m_isCharacterMapped[i] && (m_characterMap[i] == value))
+		{
+			m_characterMapReverse[value] = static_cast<std::int16_t>(i);
+			break;
+		}
+	}
+}
+
+void ConsoleScreen::poke(const unsigned int index, const Cell& cell)
+{
+	if (!priv_isCellIndexInRange(index))
+	{
+		if (m_do.throwExceptions)
+			throw Exception(exceptionPrefix + "Cannot poke cell.\nCell number (" + std::to_string(index) + ") out of range.");
+		return;
+	}
+
+	m_cells.set(priv_storageIndex(index), cell);
+
+	priv_markCellForUpdate(index);
+}
+
+void ConsoleScreen::poke(const unsigned int index, const unsigned int value)
 {
 	if (!priv_isCellIndexInRange(index))
 	{
@@ -2267,10 +2624,9 @@ void ConsoleScreen::poke(const unsigned int index, const unsigned int value)
 		return;
 	}
 
-	m_cells[index].value = value;
+	m_cells.edit(priv_storageIndex(index)).value = value;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+	priv_markCellForUpdate(index);
 }
 
 void ConsoleScreen::poke(const unsigned int index, const Color& color)
@@ -2282,10 +2638,9 @@ void ConsoleScreen::poke(const unsigned int index, const Color& color)
 		return;
 	}
 
-	m_cells[index].colors.foreground = color;
+	m_cells.edit(priv_storageIndex(index)).colors.foreground = color;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+	priv_markCellForUpdate(index);
 }
 
 void ConsoleScreen::poke(const unsigned int index, const Color& color, const Color& backgroundColor)
@@ -2297,11 +2652,10 @@ void ConsoleScreen::poke(const unsigned int index, const Color& color, const Col
 		return;
 	}
 
-	m_cells[index].colors.foreground = color;
-	m_cells[index].colors.background = backgroundColor;
+	m_cells.edit(priv_storageIndex(index)).colors.foreground = color;
+	m_cells.edit(priv_storageIndex(index)).colors.background = backgroundColor;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+	priv_markCellForUpdate(index);
 }
 
 void ConsoleScreen::poke(const unsigned int index, const StretchType& stretch)
@@ -2313,10 +2667,9 @@ void ConsoleScreen::poke(const unsigned int index, const StretchType& stretch)
 		return;
 	}
 
-	m_cells[index].stretch = stretch;
+	m_cells.edit(priv_storageIndex(index)).stretch = stretch;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+	priv_markCellForUpdate(index);
 }
 
 void ConsoleScreen::poke(const unsigned int index, const CellAttributes& cellAttributes)
@@ -2328,10 +2681,9 @@ void ConsoleScreen::poke(const unsigned int index, const CellAttributes& cellAtt
 		return;
 	}
 
-	m_cells[index].attributes = cellAttributes;
+	m_cells.edit(priv_storageIndex(index)).attributes = cellAttributes;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+	priv_markCellForUpdate(index);
 }
 
 void ConsoleScreen::poke(const unsigned int index, const bool attributeValue, const Affect& attributeMask)
@@ -2343,7 +2695,7 @@ void ConsoleScreen::poke(const unsigned int index, const bool attributeValue, co
 		return;
 	}
 
-	CellAttributes& cellAttributes{ m_cells[index].attributes };
+	CellAttributes& cellAttributes{ m_cells.edit(priv_storageIndex(index)).attributes };
 	if ((attributeMask & Affect::Inverse) == Affect::Inverse)
 		cellAttributes.inverse = attributeValue;
 	if ((attributeMask & Affect::Dark) == Affect::Dark)
@@ -2353,8 +2705,7 @@ void ConsoleScreen::poke(const unsigned int index, const bool attributeValue, co
 	if ((attributeMask & Affect::FlipY) == Affect::FlipY)
 		cellAttributes.flipY = attributeValue;
 
-	if (m_do.updateAutomatically)
-		priv_updateCell(index);
+	priv_markCellForUpdate(index);
 }
 
 ConsoleScreen::Cell ConsoleScreen::peek(const unsigned int index) const
@@ -2366,7 +2717,7 @@ ConsoleScreen::Cell ConsoleScreen::peek(const unsigned int index) const
 		return Cell();
 	}
 
-	return m_cells[index];
+	return m_cells.get(priv_storageIndex(index));
 }
 
 ConsoleScreen::Cell& ConsoleScreen::cell(const unsigned int index)
@@ -2375,10 +2726,11 @@ ConsoleScreen::Cell& ConsoleScreen::cell(const unsigned int index)
 	{
 		if (m_do.throwExceptions)
 			throw Exception(exceptionPrefix + "Cannot retrieve cell.\nCell number (" + std::to_string(index) + ") out of range.");
-		return m_cells.empty() ? fakeCell : m_cells.back();
+		return m_cells.empty() ? fakeCell : m_cells.edit(m_cells.size() - 1u);
 	}
 
-	return m_cells[index];
+	priv_markCellForUpdate(index); // the cell may be modified through the returned reference
+	return m_cells.edit(priv_storageIndex(index));
 }
 
 ConsoleScreen::Cell& ConsoleScreen::bufferCell(const unsigned int bufferIndex, const unsigned int cellIndex)
@@ -2394,63 +2746,115 @@ ConsoleScreen::Cell& ConsoleScreen::bufferCell(const unsigned int bufferIndex, c
 	{
 		if (m_do.throwExceptions)
 			throw Exception(exceptionPrefix + "Cannot retrieve buffer cell.\nCell index (" + std::to_string(cellIndex) + ") out of range.");
-		return m_buffers[bufferIndex].cells.empty() ? fakeCell : m_buffers[bufferIndex].cells.back();
+		return m_buffers[bufferIndex].cells.empty() ? fakeCell : m_buffers[bufferIndex].cells.edit(m_buffers[bufferIndex].cells.size() - 1u);
 	}
 
-	return m_buffers[bufferIndex].cells[cellIndex];
+	return m_buffers[bufferIndex].cells.edit(cellIndex);
 }
 
-
-
-
-// PRIVATE
-
-void ConsoleScreen::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void ConsoleScreen::appendVertices(VertexSink& sink, sf::RenderStates states) const
 {
+	if (m_do.updateAutomatically)
+		priv_update();
+
 	states.transform *= getTransform();
 
+	// when viewing scrollback, its rows are at the top and the screen (including its stack) is moved down
+	const unsigned int numberOfScrollbackRowsInView{ std::min(m_scrollbackViewOffset, m_mode.y) };
+	const unsigned int firstScrollbackSlot{ (numberOfScrollbackRowsInView > 0u) ? static_cast<unsigned int>((m_numberOfRowsAddedToScrollback - m_scrollbackViewOffset) % m_mode.y) : 0u };
+	const unsigned int numberOfScreenRowsInView{ m_mode.y - numberOfScrollbackRowsInView };
+	sf::RenderStates stackStates{ states };
+	if (numberOfScrollbackRowsInView > 0u)
+		stackStates.transform.translate({ 0.f, m_size.y / m_mode.y * numberOfScrollbackRowsInView });
+
 	if (m_do.showBackround && m_backgroundDisplay.size() > 0)
 	{
 		states.texture = nullptr;
-		target.draw(m_backgroundDisplay.data(), m_backgroundDisplay.size(), primitiveType, states);
+		priv_drawRows(m_scrollbackBackgroundDisplay, sink, states, firstScrollbackSlot, numberOfScrollbackRowsInView, 0u);
+		priv_drawRows(m_backgroundDisplay, sink, states, m_rowOffset, numberOfScreenRowsInView, numberOfScrollbackRowsInView);
 	}
 	states.texture = m_texture;
+	stackStates.texture = m_texture;
 	if (m_underDisplay.size() > 0u)
-		target.draw(m_underDisplay.data(), m_underDisplay.size(), primitiveType, states);
+		sink.append(m_underDisplay.data(), m_underDisplay.size(), primitiveType, stackStates);
 	if (m_display.size() > 0u)
-		target.draw(m_display.data(), m_display.size(), primitiveType, states);
+	{
+		priv_drawRows(m_scrollbackDisplay, sink, states, firstScrollbackSlot, numberOfScrollbackRowsInView, 0u);
+		priv_drawRows(m_display, sink, states, m_rowOffset, numberOfScreenRowsInView, numberOfScrollbackRowsInView);
+	}
 	if (m_overDisplay.size() > 0u)
-		target.draw(m_overDisplay.data(), m_overDisplay.size(), primitiveType, states);
+		sink.append(m_overDisplay.data(), m_overDisplay.size(), primitiveType, stackStates);
 }
 
-void ConsoleScreen::priv_setVerticesFromCell(unsigned int index, int baseVertex, const bool overLayer)
+void ConsoleScreen::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
 {
-	bool mainLayer{ (baseVertex < 0) };
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
 
-	Cell* pCell;
-	sf::Vector2f offset{ 0.f, 0.f };
-	if (mainLayer)
-		pCell = &m_cells[index];
+
+
+
+// PRIVATE
+
+void ConsoleScreen::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	if (m_displayVertexBuffer.isActive())
+	{
+		DisplayVertexBufferSink sink{ target, { { { &m_display, &m_displayVertexBuffer }, { &m_backgroundDisplay, &m_backgroundDisplayVertexBuffer } } } };
+		appendVertices(sink, states);
+	}
 	else
 	{
-		if (overLayer)
-		{
-			pCell = &m_overCells[index].cell;
-			offset = m_overCells[index].offset;
-			index = m_overCells[index].index;
-		}
-		else
-		{
-			pCell = &m_underCells[index].cell;
-			offset = m_underCells[index].offset;
-			index = m_underCells[index].index;
-		}
+		RenderTargetVertexSink sink{ target };
+		appendVertices(sink, states);
+	}
+}
+
+void ConsoleScreen::priv_drawRows(const std::vector<sf::Vertex>& vertices, VertexSink& sink, sf::RenderStates states, const unsigned int firstRow, const unsigned int numberOfRows, const unsigned int displayRow) const
+{
+	// draws rows (positioned by their storage row) wrapping around from the first row; each contiguous block is moved into place with a single append
+	if (numberOfRows == 0u)
+		return;
+
+	const std::size_t numberOfVerticesPerRow{ static_cast<std::size_t>(m_mode.x) * 6u };
+	const float rowHeight{ m_size.y / m_mode.y };
+	const unsigned int numberOfRowsBeforeWrap{ std::min(numberOfRows, m_mode.y - firstRow) };
+	sf::RenderStates blockStates{ states };
+	blockStates.transform.translate({ 0.f, rowHeight * (static_cast<float>(displayRow) - firstRow) });
+	sink.append(vertices.data() + firstRow * numberOfVerticesPerRow, numberOfRowsBeforeWrap * numberOfVerticesPerRow, primitiveType, blockStates);
+	if (numberOfRowsBeforeWrap == numberOfRows)
+		return;
+
+	states.transform.translate({ 0.f, rowHeight * (displayRow + numberOfRowsBeforeWrap) });
+	sink.append(vertices.data(), (numberOfRows - numberOfRowsBeforeWrap) * numberOfVerticesPerRow, primitiveType, states);
+}
+
+void ConsoleScreen::priv_setVerticesFromCell(unsigned int index, int baseVertex, const bool overLayer) const
+{
+	if (baseVertex < 0)
+	{
+		// main layer vertices are stored (and positioned) by storage row; draw() shifts them into place when the rows are offset
+		const unsigned int storageIndex{ priv_storageIndex(index) };
+		const bool isCursor{ (m_cursor.visible) && (m_cursorPrintProperties.index == index) };
+		const bool isCursorBottom{ (m_cursor.visible) && (m_cursorPrintProperties.stretch == Cs::StretchType::Both) && (m_cursorPrintProperties.index + m_mode.x == index) };
+		priv_setVerticesFromCell(m_cells.get(storageIndex), priv_cellLocation(storageIndex), { 0.f, 0.f }, &m_display[storageIndex * 6u], &m_backgroundDisplay[storageIndex * 6u], isCursor || isCursorBottom);
+		m_displayVertexBuffer.invalidate(storageIndex * 6u, 6u);
+		m_backgroundDisplayVertexBuffer.invalidate(storageIndex * 6u, 6u);
+		return;
 	}
-	offset.x *= static_cast<float>(m_size.x) / m_mode.x;
-	offset.y *= static_cast<float>(m_size.y) / m_mode.y;
 
+	const StackCell& stackCell{ overLayer ? m_overCells[index] : m_underCells[index] };
+	priv_setVerticesFromCell(stackCell.cell, priv_cellLocation(stackCell.index), stackCell.offset, overLayer ? &m_overDisplay[baseVertex] : &m_underDisplay[baseVertex], nullptr, false);
+}
 
-	Cell& cell{ *pCell };
+void ConsoleScreen::priv_setVerticesFromCell(const Cell& cell, const sf::Vector2u cellLocation, sf::Vector2f offset, sf::Vertex* const pVertices, sf::Vertex* const pBackgroundVertices, const bool isCursor) const
+{
+	// cells with background vertices (main layer and scrollback) resolve colour commands and darken their background
+	const bool mainLayer{ pBackgroundVertices != nullptr };
+
+	offset.x *= static_cast<float>(m_size.x) / m_mode.x;
+	offset.y *= static_cast<float>(m_size.y) / m_mode.y;
 
 	unsigned int cellValue{ cell.value };
 	sf::Color cellColor;
@@ -2460,9 +2864,8 @@ void ConsoleScreen::priv_setVerticesFromCell(unsigned int index, int baseVertex,
 
 	if (mainLayer)
 	{
-		bgColor = priv_getModifiedColorFromCellUsingSpecifiedColorType(index, ColorType::Background);
-		cellColor = getPaletteColor(priv_getModifiedColorFromCellUsingSpecifiedColorType(index, ColorType::Foreground).id);
-		//backgroundColor = getPaletteColor(priv_getModifiedColorFromCellUsingSpecifiedColorType(index, ColorType::Background).id);
+		bgColor = priv_getModifiedColorFromColorPairUsingSpecifiedColorType(cell.colors, ColorType::Background);
+		cellColor = getPaletteColor(priv_getModifiedColorFromColorPairUsingSpecifiedColorType(cell.colors, ColorType::Foreground).id);
 		backgroundColor = getPaletteColor(bgColor.id);
 	}
 	else
@@ -2472,11 +2875,9 @@ void ConsoleScreen::priv_setVerticesFromCell(unsigned int index, int baseVertex,
 		backgroundColor = getPaletteColor(bgColor.id);
 	}
 
-	const bool isCursor{ (m_cursor.visible) && (m_cursorPrintProperties.index == index) };
-	const bool isCursorBottom{ (m_cursor.visible) && (m_cursorPrintProperties.stretch == Cs::StretchType::Both) && (m_cursorPrintProperties.index + m_mode.x == index) };
 	bool useCursorValue{ false };
 
-	if (mainLayer && (isCursor || isCursorBottom))
+	if (mainLayer && isCursor)
 	{
 		if (m_cursor.value >= 0)
 		{
@@ -2501,8 +2902,8 @@ void ConsoleScreen::priv_setVerticesFromCell(unsigned int index, int baseVertex,
 			priv_makeColorDark(backgroundColor);
 	}
 
-	const unsigned int cellX{ index % m_mode.x };
-	const unsigned int cellY{ index / m_mode.x };
+	const unsigned int cellX{ cellLocation.x };
+	const unsigned int cellY{ cellLocation.y };
 	const float left{ offset.x + linearInterpolation(0.f, m_size.x, static_cast<float>(cellX + (cell.attributes.flipX ? 1 : 0)) / m_mode.x) };
 	const float right{ offset.x + linearInterpolation(0.f, m_size.x, static_cast<float>(cellX + (cell.attributes.flipX ? 0 : 1)) / m_mode.x) };
 	const float top{ offset.y + linearInterpolation(0.f, m_size.y, static_cast<float>(cellY + (cell.attributes.flipY ? 1 : 0)) / m_mode.y) };
@@ -2514,11 +2915,8 @@ void ConsoleScreen::priv_setVerticesFromCell(unsigned int index, int baseVertex,
 	const float textureRight{ -0.1f + static_cast<float>(m_textureOffset.x + (textureCell.x + 1) * m_tileSize.x) };
 	const float textureBottom{ -0.1f + static_cast<float>(m_textureOffset.y + (textureCell.y + (!useCursorValue && cell.stretch == StretchType::Top ? 0.5f : 1.f)) * m_tileSize.y) };
 
-	if (mainLayer)
-		baseVertex = index * 6u;
-	
 	// main display
-	sf::Vertex* const pVertex1{ (mainLayer ? &m_display[baseVertex] : overLayer ? &m_overDisplay[baseVertex] : &m_underDisplay[baseVertex]) };
+	sf::Vertex* const pVertex1{ pVertices };
 	sf::Vertex* const pVertex2{ pVertex1 + 1u };
 	sf::Vertex* const pVertex3{ pVertex1 + 2u };
 	sf::Vertex* const pVertex4{ pVertex1 + 3u };
@@ -2546,7 +2944,7 @@ void ConsoleScreen::priv_setVerticesFromCell(unsigned int index, int baseVertex,
 	// background display
 	if (mainLayer)
 	{
-		sf::Vertex* const pBackgroundVertex1{ &m_backgroundDisplay[baseVertex] };
+		sf::Vertex* const pBackgroundVertex1{ pBackgroundVertices };
 		sf::Vertex* const pBackgroundVertex2{ pBackgroundVertex1 + 1 };
 		sf::Vertex* const pBackgroundVertex3{ pBackgroundVertex1 + 2 };
 		sf::Vertex* const pBackgroundVertex4{ pBackgroundVertex1 + 3 };
@@ -2569,29 +2967,158 @@ void ConsoleScreen::priv_setVerticesFromCell(unsigned int index, int baseVertex,
 	}
 }
 
-void ConsoleScreen::priv_updateCell(const unsigned int index)
+void ConsoleScreen::priv_update() const
 {
-	if (!priv_isCellIndexInRange(index))
+	m_numberOfCellsUpdated = 0u;
+
+	if (m_display.size() != (m_mode.x * m_mode.y * 6u) || m_backgroundDisplay.size() != m_display.size())
 		return;
 
-	if (m_display.size() != (m_mode.x * m_mode.y * 6u))
+	for (unsigned int y{ 0u }; y < m_rowUpdateRanges.size(); ++y)
 	{
-		if (m_do.throwExceptions)
-			throw Exception(exceptionPrefix + "Bug: display does not match cells.");
+		RowUpdateRange& range{ m_rowUpdateRanges[y] };
+		if (range.begin >= range.end)
+			continue;
+
+		const unsigned int rowStartIndex{ ((y + m_mode.y - m_rowOffset) % m_mode.y) * m_mode.x };
+		for (unsigned int x{ range.begin }; x < range.end; ++x)
+			priv_setVerticesFromCell(rowStartIndex + x);
+		m_numberOfCellsUpdated += range.end - range.begin;
+		range = { 0u, 0u };
+	}
+
+	if (m_isStackUpdateRequired)
+	{
+		priv_updateUnderCells();
+		priv_updateOverCells();
+		m_isStackUpdateRequired = false;
+	}
+
+	if (m_scrollbackViewOffset > 0u)
+		priv_updateScrollbackDisplay();
+}
+
+void ConsoleScreen::priv_updateScrollbackDisplay() const
+{
+	if (m_mode.x == 0u || m_scrollbackDisplay.size() != m_display.size() || m_scrollbackBackgroundDisplay.size() != m_display.size() || m_scrollbackDisplayRows.size() != m_mode.y)
 		return;
+
+	// scrollback rows never change so only rows not already in their slot are updated
+	const std::size_t oldestRow{ m_numberOfRowsAddedToScrollback - m_numberOfScrollbackRows };
+	const std::size_t firstRowInView{ m_numberOfRowsAddedToScrollback - m_scrollbackViewOffset };
+	const unsigned int numberOfRowsInView{ std::min(m_scrollbackViewOffset, m_mode.y) };
+	const unsigned int numberOfStorageRows{ static_cast<unsigned int>(m_scrollbackCells.size() / m_mode.x) };
+	for (std::size_t row{ firstRowInView }; row < firstRowInView + numberOfRowsInView; ++row)
+	{
+		const unsigned int slot{ static_cast<unsigned int>(row % m_mode.y) };
+		if (m_scrollbackDisplayRows[slot] == row)
+			continue;
+
+		const unsigned int storageRowStartIndex{ static_cast<unsigned int>((m_scrollbackFirstRow + (row - oldestRow)) % numberOfStorageRows) * m_mode.x };
+		for (unsigned int x{ 0u }; x < m_mode.x; ++x)
+		{
+			const std::size_t baseVertex{ (static_cast<std::size_t>(slot) * m_mode.x + x) * 6u };
+			priv_setVerticesFromCell(m_scrollbackCells.get(storageRowStartIndex + x), { x, slot }, { 0.f, 0.f }, &m_scrollbackDisplay[baseVertex], &m_scrollbackBackgroundDisplay[baseVertex], false);
+		}
+		m_scrollbackDisplayRows[slot] = row;
+		m_numberOfCellsUpdated += m_mode.x;
 	}
+}
 
-	if (m_display.size() < 6u)
+void ConsoleScreen::priv_invalidateScrollbackDisplay()
+{
+	std::fill(m_scrollbackDisplayRows.begin(), m_scrollbackDisplayRows.end(), noScrollbackRow);
+}
+
+void ConsoleScreen::priv_addTopRowToScrollback()
+{
+	if (m_numberOfScrollbackRows < m_scrollbackSize)
 	{
-		if (m_do.throwExceptions)
-			throw Exception(exceptionPrefix + "Bug: cannot update cell. No cells available.");
+		// storage grows (in order) until full
+		for (unsigned int x{ 0u }; x < m_mode.x; ++x)
+			m_scrollbackCells.pushBack(m_cells.get(priv_storageIndex(x)));
+		++m_numberOfScrollbackRows;
+	}
+	else
+	{
+		// oldest row is replaced
+		const unsigned int storageRowStartIndex{ m_scrollbackFirstRow * m_mode.x };
+		for (unsigned int x{ 0u }; x < m_mode.x; ++x)
+			m_scrollbackCells.set(storageRowStartIndex + x, m_cells.get(priv_storageIndex(x)));
+		m_scrollbackFirstRow = (m_scrollbackFirstRow + 1u) % m_scrollbackSize;
+	}
+	++m_numberOfRowsAddedToScrollback;
+
+	// the view stays on the same rows while scrolled back
+	if (m_scrollbackViewOffset > 0u)
+		m_scrollbackViewOffset = std::min(m_scrollbackViewOffset + 1u, m_numberOfScrollbackRows);
+}
+
+void ConsoleScreen::priv_markCellForUpdate(const unsigned int index)
+{
+	if (!priv_isCellIndexInRange(index))
 		return;
+
+	RowUpdateRange& range{ m_rowUpdateRanges[priv_storageIndex(index) / m_mode.x] };
+	const unsigned int x{ index % m_mode.x };
+	if (range.begin >= range.end)
+		range = { x, x + 1u };
+	else if (x < range.begin)
+		range.begin = x;
+	else if (x >= range.end)
+		range.end = x + 1u;
+}
+
+void ConsoleScreen::priv_markAllCellsForUpdate()
+{
+	for (auto& range : m_rowUpdateRanges)
+		range = { 0u, m_mode.x };
+	m_isStackUpdateRequired = true;
+	priv_invalidateScrollbackDisplay();
+}
+
+void ConsoleScreen::priv_markSelectionRectangleForUpdate(const sf::IntRect& selectionRectangle)
+{
+	const unsigned int left{ static_cast<unsigned int>(selectionRectangle.position.x) };
+	const unsigned int right{ left + static_cast<unsigned int>(selectionRectangle.size.x) };
+	const unsigned int top{ static_cast<unsigned int>(selectionRectangle.position.y) };
+	const unsigned int bottom{ top + static_cast<unsigned int>(selectionRectangle.size.y) };
+	if (left >= right)
+		return;
+	for (unsigned int y{ top }; y < bottom; ++y) // marking both ends of a row also includes every cell between them
+	{
+		priv_markCellForUpdate(priv_cellIndex({ left, y }));
+		priv_markCellForUpdate(priv_cellIndex({ right - 1u, y }));
 	}
+}
 
-	priv_setVerticesFromCell(index);
+void ConsoleScreen::priv_markCellsUsingPaletteRangeForUpdate(const long int firstColorId, const long int lastColorId)
+{
+	// colour commands are resolved using the palette so those cells are always affected
+	const auto isAffected = [&firstColorId, &lastColorId](const Color& color) { return (color.id < 0) || (color.id >= firstColorId && color.id <= lastColorId); };
+	for (unsigned int i{ 0u }; i < m_cells.size(); ++i)
+	{
+		if (isAffected(m_cells.get(priv_storageIndex(i)).colors.foreground) || isAffected(m_cells.get(priv_storageIndex(i)).colors.background))
+			priv_markCellForUpdate(i);
+	}
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
+	m_isStackUpdateRequired = true;
+	priv_invalidateScrollbackDisplay();
 }
 
-void ConsoleScreen::priv_updateUnderCells()
+void ConsoleScreen::priv_markCellsWithDarkAttributeForUpdate()
+{
+	for (unsigned int i{ 0u }; i < m_cells.size(); ++i)
+	{
+		if (m_cells.get(priv_storageIndex(i)).attributes.dark)
+			priv_markCellForUpdate(i);
+	}
+	m_isStackUpdateRequired = true;
+	priv_invalidateScrollbackDisplay();
+}
+
+void ConsoleScreen::priv_updateUnderCells() const
 {
 	m_underDisplay.resize(m_underCells.size() * 6u);
 	unsigned int outOfRangeCells{ 0u };
@@ -2612,7 +3139,7 @@ void ConsoleScreen::priv_updateUnderCells()
 		m_underDisplay.resize(baseVertex);
 }
 
-void ConsoleScreen::priv_updateOverCells()
+void ConsoleScreen::priv_updateOverCells() const
 {
 	m_overDisplay.resize(m_overCells.size() * 6u);
 	unsigned int outOfRangeCells{ 0u };
@@ -2643,6 +3170,52 @@ sf::Vector2u ConsoleScreen::priv_cellLocation(const unsigned int index) const
 	return{ index % m_mode.x, index / m_mode.x };
 }
 
+unsigned int ConsoleScreen::priv_storageIndex(const unsigned int index) const
+{
+	if (m_rowOffset == 0u)
+		return index;
+
+	const unsigned int storageRow{ index / m_mode.x + m_rowOffset };
+	return (storageRow < m_mode.y ? storageRow : storageRow - m_mode.y) * m_mode.x + index % m_mode.x;
+}
+
+unsigned int ConsoleScreen::priv_storageIndex(const sf::Vector2u location) const
+{
+	const unsigned int storageRow{ location.y + m_rowOffset };
+	return (storageRow < m_mode.y ? storageRow : storageRow - m_mode.y) * m_mode.x + location.x;
+}
+
+void ConsoleScreen::priv_offsetRows(const int amount)
+{
+	if (m_mode.y == 0u)
+		return;
+
+	// the cursor is displayed in the cell it occupies in storage so that cell is updated both before and after the move
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
+	const int numberOfRows{ static_cast<int>(m_mode.y) };
+	m_rowOffset = static_cast<unsigned int>(((static_cast<int>(m_rowOffset) + amount) % numberOfRows + numberOfRows) % numberOfRows);
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
+}
+
+void ConsoleScreen::priv_resetRowOffset()
+{
+	if (m_rowOffset == 0u)
+		return;
+
+	m_cells.rotate(m_rowOffset * m_mode.x);
+	m_rowOffset = 0u;
+	priv_markAllCellsForUpdate();
+}
+
+ConsoleScreen::CellStorage ConsoleScreen::priv_getCellsInScreenOrder() const
+{
+	CellStorage cells{ m_cells };
+	cells.rotate(m_rowOffset * m_mode.x);
+	return cells;
+}
+
 bool ConsoleScreen::priv_isCellIndexInRange(const unsigned int index) const
 {
 	return index < m_cells.size();
@@ -2670,14 +3243,14 @@ bool ConsoleScreen::priv_isColorInPaletteRange(const Color color) const
 
 void ConsoleScreen::priv_clearCell(const unsigned int index, const bool overwriteColor, const bool overwriteBackgroundColor)
 {
-	const Color color{ overwriteColor ? m_cursorPrintProperties.colors.foreground : m_cells[index].colors.foreground };
-	const Color backgroundColor{ overwriteBackgroundColor ? m_cursorPrintProperties.colors.background : m_cells[index].colors.background };
+	const Color color{ overwriteColor ? m_cursorPrintProperties.colors.foreground : m_cells.get(priv_storageIndex(index)).colors.foreground };
+	const Color backgroundColor{ overwriteBackgroundColor ? m_cursorPrintProperties.colors.background : m_cells.get(priv_storageIndex(index)).colors.background };
 	poke(index, { m_clearValue, ColorPair(color, backgroundColor), StretchType::None, CellAttributes() });
 }
 
 void ConsoleScreen::priv_clearCell(const unsigned int index, const Color& backgroundColor, const bool overwriteColor)
 {
-	const Color color{ overwriteColor ? m_cursorPrintProperties.colors.foreground : m_cells[index].colors.foreground };
+	const Color color{ overwriteColor ? m_cursorPrintProperties.colors.foreground : m_cells.get(priv_storageIndex(index)).colors.foreground };
 	poke(index, { m_clearValue, ColorPair(color, backgroundColor), StretchType::None, CellAttributes() });
 }
 
@@ -2691,15 +3264,12 @@ void ConsoleScreen::priv_setCursorIndex(const unsigned int index)
 	const unsigned int previousIndex{ m_cursorPrintProperties.index };
 	m_cursorPrintProperties.index = index;
 
-	if (m_do.updateAutomatically)
+	priv_markCellForUpdate(previousIndex);
+	priv_markCellForUpdate(m_cursorPrintProperties.index);
+	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
 	{
-		priv_updateCell(previousIndex);
-		priv_updateCell(m_cursorPrintProperties.index);
-		if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
-		{
-			priv_updateCell(previousIndex + m_mode.x);
-			priv_updateCell(m_cursorPrintProperties.index + m_mode.x);
-		}
+		priv_markCellForUpdate(previousIndex + m_mode.x);
+		priv_markCellForUpdate(m_cursorPrintProperties.index + m_mode.x);
 	}
 }
 
@@ -2743,14 +3313,11 @@ bool ConsoleScreen::priv_testCursorForScroll()
 		{
 			result = true;
 			priv_scroll();
-			if (m_do.updateAutomatically)
-				update();
 		}
 		else
 		{
 			m_cursorPrintProperties.index = static_cast<unsigned int>(m_cells.size()) - 1u;
-			if (m_do.updateAutomatically)
-				update();
+			priv_markCellForUpdate(m_cursorPrintProperties.index);
 		}
 	}
 	if (priv_getCurrentPrintProperties().stretch == Cs::StretchType::Both)
@@ -2765,16 +3332,29 @@ bool ConsoleScreen::priv_testCursorForScroll()
 
 void ConsoleScreen::priv_scroll()
 {
+	if (m_scrollbackSize > 0u)
+		priv_addTopRowToScrollback();
+
+	if (m_do.useRowRingBuffer)
+	{
+		priv_offsetRows(1);
+		for (unsigned int x{ 0 }; x < m_mode.x; ++x)
+			priv_clearCell(priv_cellIndex({ x, m_mode.y - 1u }), true, true);
+		priv_moveCursorUp();
+		return;
+	}
+
 	for (unsigned int y{ 0 }; y < m_mode.y; ++y)
 	{
 		for (unsigned int x{ 0 }; x < m_mode.x; ++x)
 		{
 			if (y < m_mode.y - 1)
-				m_cells[priv_cellIndex({ x, y })] = m_cells[priv_cellIndex({ x, y + 1 })];
+				m_cells.copy(priv_storageIndex({ x, y }), priv_storageIndex({ x, y + 1 }));
 			else
 				priv_clearCell(priv_cellIndex({ x, y }), true, true);
 		}
 	}
+	priv_markAllCellsForUpdate();
 	priv_moveCursorUp();
 }
 
@@ -2805,7 +3385,7 @@ void ConsoleScreen::priv_copyToBufferFromSelectionRectangle(Buffer& buffer, cons
 			const sf::Vector2u cellLocation{ static_cast<unsigned int>(location.x), static_cast<unsigned int>(location.y) };
 			if (priv_isCellLocationInRange(cellLocation))
 			{
-				buffer.cells.push_back(m_cells[priv_cellIndex(cellLocation)]);
+				buffer.cells.pushBack(m_cells.get(priv_storageIndex(cellLocation)));
 				if (y == 0)
 					++buffer.width;
 			}
@@ -2822,11 +3402,11 @@ void ConsoleScreen::priv_pasteOffsettedBuffer(Buffer& buffer, const sf::Vector2i
 			continue;
 		const sf::Vector2u cellLocation{ static_cast<unsigned int>(location.x), static_cast<unsigned int>(location.y) };
 		if (priv_isCellLocationInRange(cellLocation))
-			m_cells[priv_cellIndex(cellLocation)] = buffer.cells[i];
+		{
+			m_cells.set(priv_storageIndex(cellLocation), buffer.cells.get(i));
+			priv_markCellForUpdate(priv_cellIndex(cellLocation));
+		}
 	}
-
-	if (m_do.updateAutomatically)
-		update();
 }
 
 bool ConsoleScreen::priv_isSelectionRectangleContainedInScreen(const sf::IntRect& selectionRectangle)
@@ -2857,25 +3437,31 @@ unsigned int ConsoleScreen::priv_getPrintIndex(sf::Vector2u location) const
 
 unsigned int ConsoleScreen::priv_getCellValueFromCharacter(const char character) const
 {
-	if (getIsMappedCharacter(character))
-		return m_characterMap.at(character);
-	else
-		return valueFromChar(character);
+	return m_characterMap[static_cast<unsigned char>(character)];
 }
 
 char ConsoleScreen::priv_getCharacterFromCellValue(const unsigned int cellValue) const
 {
-	for (auto& pair : m_characterMap)
+	if (cellValue < m_characterMapReverse.size())
+	{
+		const std::int16_t character{ m_characterMapReverse[cellValue] };
+		if (character != noReverseCharacter)
+			return static_cast<char>(character);
+	}
+	else if (cellValue > maximumReverseCharacterMapValue)
 	{
-		if (pair.second == cellValue)
-			return pair.first;
+		for (unsigned int i{ 0u }; i < m_characterMap.size(); ++i)
+		{
+			if (m_isCharacterMapped[i] && (m_characterMap[i] == cellValue))
+				return static_cast<char>(i);
+		}
 	}
 	return static_cast<char>(cellValue);
 }
 
 ConsoleScreen::Color ConsoleScreen::priv_getRandomColor() const
 {
-	return Color(std::uniform_int_distribution<unsigned long int>(0u, m_is.rgbMode ? 16777215L : static_cast<unsigned long int>(m_palette.size()) - 1u)(randomGenerator));
+	return Color(static_cast<long int>(m_random.getInteger(m_is.rgbMode ? 16777215u : static_cast<std::uint32_t>(m_palette.size()) - 1u)));
 }
 
 ConsoleScreen::PrintProperties& ConsoleScreen::priv_getCurrentPrintProperties()
@@ -2900,7 +3486,7 @@ ConsoleScreen::PrintProperties& ConsoleScreen::priv_getPrintProperties(const Pri
 	}
 }
 
-ConsoleScreen::Color ConsoleScreen::priv_getModifiedColorFromColorPairUsingSpecifiedColorType(const ColorPair& colors, const ColorType& colorType)
+ConsoleScreen::Color ConsoleScreen::priv_getModifiedColorFromColorPairUsingSpecifiedColorType(const ColorPair& colors, const ColorType& colorType) const
 {
 	const Color& focusColor{ (colorType == ColorType::Foreground ? colors.foreground : colors.background) };
 	const Color& supportColor{ (colorType == ColorType::Foreground ? colors.background : colors.foreground) };
@@ -2937,9 +3523,9 @@ ConsoleScreen::Color ConsoleScreen::priv_getModifiedColorFromColorPairUsingSpeci
 	return color;
 }
 
-ConsoleScreen::Color ConsoleScreen::priv_getModifiedColorFromCellUsingSpecifiedColorType(const unsigned int& cellIndex, const ColorType& colorType)
+ConsoleScreen::Color ConsoleScreen::priv_getModifiedColorFromCellUsingSpecifiedColorType(const unsigned int& cellIndex, const ColorType& colorType) const
 {
-	return priv_getModifiedColorFromColorPairUsingSpecifiedColorType(m_cells[cellIndex].colors, colorType);
+	return priv_getModifiedColorFromColorPairUsingSpecifiedColorType(m_cells.get(priv_storageIndex(cellIndex)).colors, colorType);
 }
 
 ConsoleScreen::Color& ConsoleScreen::priv_getActiveColor()
@@ -2959,8 +3545,7 @@ int ConsoleScreen::priv_getIndexOfClosestPaletteColor(const sf::Color& color) co
 	int index{ -1 }; // returns -1 if the palette is empty
 	int currentDistance{ 195076 }; // 195076 = 255 * 255 * 3 + 1 (one further than the maximum possible distance)
 
-	const unsigned int numberOfColorsInPalette{ static_cast<unsigned int>(m_palette.size()) };
-	for (unsigned int i{ 0u }; i < numberOfColorsInPalette; ++i)
+	const auto testPaletteColor = [&](const unsigned int i)
 	{
 		const int r{ static_cast<int>(m_palette[i].r) - color.r };
 		const int g{ static_cast<int>(m_palette[i].g) - color.g };
@@ -2971,31 +3556,106 @@ int ConsoleScreen::priv_getIndexOfClosestPaletteColor(const sf::Color& color) co
 			index = i;
 			currentDistance = distance;
 		}
+	};
+
+	const unsigned int numberOfColorsInPalette{ static_cast<unsigned int>(m_palette.size()) };
+	if (numberOfColorsInPalette <= maximumPaletteSizeForLinearSearch)
+	{
+		for (unsigned int i{ 0u }; i < numberOfColorsInPalette; ++i)
+			testPaletteColor(i);
+		return index;
 	}
 
+	// only the candidates for the region are tested. they are in palette order so ties resolve to the same colour as testing the entire palette
+	for (const auto& i : priv_getPaletteLookupCandidates(color))
+		testPaletteColor(i);
 	return index;
 }
 
-std::string ConsoleScreen::priv_read(unsigned int index, const bool unmapCharacters)
+const std::vector<unsigned int>& ConsoleScreen::priv_getPaletteLookupCandidates(const sf::Color& color) const
 {
-	std::string string;
+	if (!m_isPaletteLookupValid)
+	{
+		m_paletteLookupRegions.resize(paletteLookupRegionsPerChannel * paletteLookupRegionsPerChannel * paletteLookupRegionsPerChannel);
+		for (auto& region : m_paletteLookupRegions)
+			region.clear();
+		m_isPaletteLookupValid = true;
+	}
 
-	for (unsigned int i{ 0u }; i < m_readLength; ++i)
+	const sf::Vector3<unsigned int> region{ color.r / paletteLookupRegionSize, color.g / paletteLookupRegionSize, color.b / paletteLookupRegionSize };
+	std::vector<unsigned int>& candidates{ m_paletteLookupRegions[(region.x * paletteLookupRegionsPerChannel + region.y) * paletteLookupRegionsPerChannel + region.z] };
+	if (!candidates.empty())
+		return candidates;
+
+	// a palette colour is a candidate if its minimum distance to the region is not greater than the smallest maximum distance of any palette colour to the region.
+	// the closest palette colour to any colour within the region is always a candidate
+	const sf::Vector3<unsigned int> regionMin{ region.x * paletteLookupRegionSize, region.y * paletteLookupRegionSize, region.z * paletteLookupRegionSize };
+	const sf::Vector3<unsigned int> regionMax{ regionMin.x + paletteLookupRegionSize - 1u, regionMin.y + paletteLookupRegionSize - 1u, regionMin.z + paletteLookupRegionSize - 1u };
+	const auto minimumChannelDistance = [](const unsigned int channel, const unsigned int min, const unsigned int max)
 	{
-		string += (unmapCharacters ? priv_getCharacterFromCellValue(m_cells[index].value) : static_cast<char>(m_cells[index].value));
-		++index;
-		if (!priv_isCellIndexInRange(index))
-			break;
-		priv_getCurrentPrintProperties().index = index;
+		return (channel < min) ? min - channel : ((channel > max) ? channel - max : 0u);
+	};
+	const auto maximumChannelDistance = [](const unsigned int channel, const unsigned int min, const unsigned int max)
+	{
+		return std::max(channel > min ? channel - min : min - channel, channel > max ? channel - max : max - channel);
+	};
+	const auto squared = [](const unsigned int value) { return value * value; };
+
+	const unsigned int numberOfColorsInPalette{ static_cast<unsigned int>(m_palette.size()) };
+	std::vector<unsigned int> minimumDistances(numberOfColorsInPalette);
+	unsigned int smallestMaximumDistance{ std::numeric_limits<unsigned int>::max() };
+	for (unsigned int i{ 0u }; i < numberOfColorsInPalette; ++i)
+	{
+		const sf::Color& paletteColor{ m_palette[i] };
+		minimumDistances[i] = squared(minimumChannelDistance(paletteColor.r, regionMin.x, regionMax.x)) + squared(minimumChannelDistance(paletteColor.g, regionMin.y, regionMax.y)) + squared(minimumChannelDistance(paletteColor.b, regionMin.z, regionMax.z));
+		const unsigned int maximumDistance{ squared(maximumChannelDistance(paletteColor.r, regionMin.x, regionMax.x)) + squared(maximumChannelDistance(paletteColor.g, regionMin.y, regionMax.y)) + squared(maximumChannelDistance(paletteColor.b, regionMin.z, regionMax.z)) };
+		if (maximumDistance < smallestMaximumDistance)
+			smallestMaximumDistance = maximumDistance;
+	}
+	for (unsigned int i{ 0u }; i < numberOfColorsInPalette; ++i)
+	{
+		if (minimumDistances[i] <= smallestMaximumDistance)
+			candidates.push_back(i);
 	}
+	return candidates;
+}
 
-	return string;
+std::size_t ConsoleScreen::priv_read(unsigned int index, char* const characters, const std::size_t size, const bool unmapCharacters)
+{
+	if (!priv_isCellIndexInRange(index))
+		return 0u;
+
+	const unsigned int numberOfCells{ getNumberOfCells() };
+	const std::size_t numberOfCharacters{ std::min({ static_cast<std::size_t>(m_readLength), static_cast<std::size_t>(numberOfCells - index), size }) };
+	for (std::size_t i{ 0u }; i < numberOfCharacters; ++i)
+	{
+		const unsigned int value{ m_cells.get(priv_storageIndex(index + static_cast<unsigned int>(i))).value };
+		characters[i] = unmapCharacters ? priv_getCharacterFromCellValue(value) : static_cast<char>(value);
+	}
+
+	// print index moves past the characters read but stays on the last cell if the end of the screen is reached
+	if (numberOfCharacters > 0u)
+		priv_getCurrentPrintProperties().index = std::min(index + static_cast<unsigned int>(numberOfCharacters), numberOfCells - 1u);
+
+	return numberOfCharacters;
+}
+
+sf::IntRect ConsoleScreen::priv_getSelectionRectangleClippedToScreen(const sf::IntRect selectionRectangle) const
+{
+	const sf::Vector2i begin{ std::max(selectionRectangle.position.x, 0), std::max(selectionRectangle.position.y, 0) };
+	const sf::Vector2i end{ std::min(selectionRectangle.position.x + selectionRectangle.size.x, static_cast<int>(m_mode.x)), std::min(selectionRectangle.position.y + selectionRectangle.size.y, static_cast<int>(m_mode.y)) };
+	if ((end.x <= begin.x) || (end.y <= begin.y))
+		return{ { 0, 0 }, { 0, 0 } };
+	return{ begin, end - begin };
 }
 
 void ConsoleScreen::priv_modifyCellUsingPrintProperties(const unsigned int index, const PrintType& printType, const StretchType stretch)
 {
-	PrintProperties& printProperties{ priv_getPrintProperties(printType) };
-	Cell& currentCell = m_cells[index];
+	priv_modifyCellUsingPrintProperties(m_cells.edit(priv_storageIndex(index)), priv_getPrintProperties(printType), stretch);
+}
+
+void ConsoleScreen::priv_modifyCellUsingPrintProperties(Cell& currentCell, const PrintProperties& printProperties, const StretchType stretch) const
+{
 	if ((printProperties.affectBitmask & Affect::FgColor) == Affect::FgColor)
 		currentCell.colors.foreground = printProperties.colors.foreground;
 	if ((printProperties.affectBitmask & Affect::BgColor) == Affect::BgColor)
@@ -3012,11 +3672,541 @@ void ConsoleScreen::priv_modifyCellUsingPrintProperties(const unsigned int index
 		currentCell.stretch = stretch;
 }
 
-void ConsoleScreen::priv_makeColorDark(sf::Color& color)
+void ConsoleScreen::priv_printRun(const char* const characters, const std::size_t numberOfCharacters)
+{
+	// equivalent to printing each character separately but print properties are resolved once for the entire run
+	if (numberOfCharacters == 0u)
+		return;
+
+	PrintProperties& printProperties{ priv_getCurrentPrintProperties() };
+	const bool doAlterValue{ (printProperties.affectBitmask & Affect::Value) == Affect::Value };
+	const bool isStretchedOverTwoRows{ printProperties.stretch == StretchType::Both };
+	const StretchType stretch{ isStretchedOverTwoRows ? StretchType::Top : printProperties.stretch };
+	const unsigned int numberOfCells{ static_cast<unsigned int>(m_cells.size()) };
+	const unsigned int scrollTestIndex{ isStretchedOverTwoRows ? ((numberOfCells > m_mode.x) ? numberOfCells - m_mode.x : 0u) : numberOfCells };
+
+	for (std::size_t i{ 0u }; i < numberOfCharacters; ++i)
+	{
+		if (!priv_isCellIndexInRange(printProperties.index))
+			return;
+
+		const unsigned int currentIndex{ printProperties.index };
+		const unsigned int value{ doAlterValue ? priv_getCellValueFromCharacter(characters[i]) : 0u };
+		Cell& currentCell{ m_cells.edit(priv_storageIndex(currentIndex)) };
+		if (doAlterValue)
+			currentCell.value = value;
+		priv_modifyCellUsingPrintProperties(currentCell, printProperties, stretch);
+		priv_markCellForUpdate(currentIndex);
+
+		const unsigned int belowIndex{ currentIndex + m_mode.x };
+		if (isStretchedOverTwoRows && belowIndex < numberOfCells)
+		{
+			Cell& belowCell{ m_cells.edit(priv_storageIndex(belowIndex)) };
+			priv_modifyCellUsingPrintProperties(belowCell, printProperties, StretchType::Bottom);
+			if (doAlterValue)
+				belowCell.value = value;
+			priv_markCellForUpdate(belowIndex);
+		}
+
+		++printProperties.index;
+		if (isStretchedOverTwoRows && (printProperties.index % m_mode.x == 0))
+			printProperties.index += m_mode.x;
+		if (!m_is.directPrinting)
+		{
+			if (printProperties.index >= scrollTestIndex)
+				priv_testCursorForScroll();
+		}
+		else if (printProperties.index >= numberOfCells)
+			printProperties.index = numberOfCells - 1u;
+	}
+
+	priv_markCellForUpdate(printProperties.index);
+	if (isStretchedOverTwoRows)
+		priv_markCellForUpdate(printProperties.index + m_mode.x);
+}
+
+void ConsoleScreen::priv_executeStreamControlCharacter(const char character)
+{
+	switch (character)
+	{
+	case '\n':
+		*this << CursorCommand::Newline;
+		break;
+	case '\r':
+		*this << CursorCommand::HomeLine;
+		break;
+	case '\b':
+		*this << CursorCommand::Left;
+		break;
+	case '\t':
+		*this << CursorCommand::Tab;
+		break;
+	default:
+		; // other control characters (including bell) are ignored
+	}
+}
+
+void ConsoleScreen::priv_executeStreamControlSequence(const char finalCharacter)
+{
+	const auto parameter = [&](const std::size_t parameterIndex, const unsigned int defaultValue)
+	{
+		return (parameterIndex < m_stream.parameters.size()) ? m_stream.parameters[parameterIndex] : defaultValue;
+	};
+	const auto amount = [&]() { return std::max(parameter(0u, 1u), 1u); }; // zero is treated the same as one
+
+	if (m_stream.isPrivateSequence)
+	{
+		// only cursor visibility ("?25h" and "?25l") is supported
+		if ((finalCharacter == 'h' || finalCharacter == 'l') && parameter(0u, 0u) == 25u)
+			setShowCursor(finalCharacter == 'h');
+		return;
+	}
+
+	if (m_mode.x == 0u || m_mode.y == 0u)
+		return;
+
+	const Location location{ priv_cellLocation(priv_getCurrentPrintProperties().index) };
+	const auto clampedLocation = [&](const long int x, const long int y)
+	{
+		return Location(static_cast<unsigned int>(std::clamp(x, 0L, static_cast<long int>(m_mode.x) - 1L)), static_cast<unsigned int>(std::clamp(y, 0L, static_cast<long int>(m_mode.y) - 1L)));
+	};
+	switch (finalCharacter)
+	{
+	case 'm':
+		priv_executeStreamSelectGraphicRendition();
+		break;
+	case 'A':
+		*this << clampedLocation(location.x, static_cast<long int>(location.y) - amount());
+		break;
+	case 'B':
+	case 'e':
+		*this << clampedLocation(location.x, static_cast<long int>(location.y) + amount());
+		break;
+	case 'C':
+	case 'a':
+		*this << clampedLocation(static_cast<long int>(location.x) + amount(), location.y);
+		break;
+	case 'D':
+		*this << clampedLocation(static_cast<long int>(location.x) - amount(), location.y);
+		break;
+	case 'E':
+		*this << clampedLocation(0L, static_cast<long int>(location.y) + amount());
+		break;
+	case 'F':
+		*this << clampedLocation(0L, static_cast<long int>(location.y) - amount());
+		break;
+	case 'G':
+	case '`':
+		*this << clampedLocation(static_cast<long int>(amount()) - 1L, location.y);
+		break;
+	case 'd':
+		*this << clampedLocation(location.x, static_cast<long int>(amount()) - 1L);
+		break;
+	case 'H':
+	case 'f':
+		*this << clampedLocation(static_cast<long int>(std::max(parameter(1u, 1u), 1u)) - 1L, static_cast<long int>(amount()) - 1L);
+		break;
+	case 'J':
+	{
+		const unsigned int index{ priv_cellIndex(location) };
+		switch (parameter(0u, 0u))
+		{
+		case 0u:
+			priv_eraseCellsForStream(index, getNumberOfCells());
+			break;
+		case 1u:
+			priv_eraseCellsForStream(0u, index + 1u);
+			break;
+		default:
+			priv_eraseCellsForStream(0u, getNumberOfCells());
+		}
+	}
+		break;
+	case 'K':
+	{
+		const unsigned int index{ priv_cellIndex(location) };
+		const unsigned int rowStartIndex{ index - location.x };
+		switch (parameter(0u, 0u))
+		{
+		case 0u:
+			priv_eraseCellsForStream(index, rowStartIndex + m_mode.x);
+			break;
+		case 1u:
+			priv_eraseCellsForStream(rowStartIndex, index + 1u);
+			break;
+		default:
+			priv_eraseCellsForStream(rowStartIndex, rowStartIndex + m_mode.x);
+		}
+	}
+		break;
+	case 's':
+		m_stream.savedLocation = location;
+		break;
+	case 'u':
+		*this << clampedLocation(m_stream.savedLocation.x, m_stream.savedLocation.y);
+		break;
+	default:
+		; // unsupported sequences are ignored
+	}
+}
+
+void ConsoleScreen::priv_executeStreamSelectGraphicRendition()
+{
+	PrintProperties& printProperties{ priv_getCurrentPrintProperties() };
+	if (m_stream.parameters.empty())
+		m_stream.parameters.push_back(0u);
+
+	// an attribute must be affected to be printed but, once it is reset, prints should leave it alone again (unless it was already affected)
+	const auto addAffect = [&](const unsigned int affect)
+	{
+		m_stream.addedAffectBitmask |= affect & ~printProperties.affectBitmask;
+		printProperties.affectBitmask |= affect;
+	};
+	const auto removeAddedAffect = [&](const unsigned int affect)
+	{
+		printProperties.affectBitmask &= ~(m_stream.addedAffectBitmask & affect);
+		m_stream.addedAffectBitmask &= ~affect;
+	};
+
+	for (std::size_t i{ 0u }; i < m_stream.parameters.size(); ++i)
+	{
+		const unsigned int parameter{ m_stream.parameters[i] };
+		if (parameter >= 30u && parameter <= 37u)
+			printProperties.colors.foreground = priv_getColorFromStreamColorNumber(parameter - 30u);
+		else if (parameter >= 90u && parameter <= 97u)
+			printProperties.colors.foreground = priv_getColorFromStreamColorNumber(parameter - 90u + 8u);
+		else if (parameter >= 40u && parameter <= 47u)
+			printProperties.colors.background = priv_getColorFromStreamColorNumber(parameter - 40u);
+		else if (parameter >= 100u && parameter <= 107u)
+			printProperties.colors.background = priv_getColorFromStreamColorNumber(parameter - 100u + 8u);
+		else if (parameter == 38u || parameter == 48u)
+		{
+			// extended colour: "5;n" (256-colour number) or "2;r;g;b" (RGB)
+			Color& color{ (parameter == 38u) ? printProperties.colors.foreground : printProperties.colors.background };
+			const unsigned int colorSpace{ (i + 1u < m_stream.parameters.size()) ? m_stream.parameters[i + 1u] : 0u };
+			if (colorSpace == 5u && i + 2u < m_stream.parameters.size())
+			{
+				color = priv_getColorFromStreamColorNumber(m_stream.parameters[i + 2u]);
+				i += 2u;
+			}
+			else if (colorSpace == 2u && i + 4u < m_stream.parameters.size())
+			{
+				const auto channel = [&](const std::size_t channelIndex) { return static_cast<std::uint8_t>(std::min(m_stream.parameters[i + channelIndex], 255u)); };
+				color = getClosestPaletteColor(sf::Color(channel(2u), channel(3u), channel(4u)));
+				i += 4u;
+			}
+			else
+				i = m_stream.parameters.size();
+		}
+		else
+		{
+			switch (parameter)
+			{
+			case 0u:
+				printProperties.colors = m_defaultPrintProperties.colors;
+				printProperties.attributes = CellAttributes();
+				removeAddedAffect(Affect::Dark | Affect::Inverse);
+				break;
+			case 2u:
+				printProperties.attributes.dark = true;
+				addAffect(Affect::Dark);
+				break;
+			case 7u:
+				printProperties.attributes.inverse = true;
+				addAffect(Affect::Inverse);
+				break;
+			case 22u:
+				printProperties.attributes.dark = false;
+				removeAddedAffect(Affect::Dark);
+				break;
+			case 27u:
+				printProperties.attributes.inverse = false;
+				removeAddedAffect(Affect::Inverse);
+				break;
+			case 39u:
+				printProperties.colors.foreground = m_defaultPrintProperties.colors.foreground;
+				break;
+			case 49u:
+				printProperties.colors.background = m_defaultPrintProperties.colors.background;
+				break;
+			default:
+				; // unsupported renditions (such as bold and underline) are ignored
+			}
+		}
+	}
+}
+
+void ConsoleScreen::priv_eraseCellsForStream(const unsigned int beginIndex, const unsigned int endIndex)
+{
+	for (unsigned int i{ beginIndex }; i < endIndex && i < m_cells.size(); ++i)
+		priv_clearCell(i, true, true);
+}
+
+ConsoleScreen::Color ConsoleScreen::priv_getColorFromStreamColorNumber(const unsigned int colorNumber) const
+{
+	return getClosestPaletteColor(xtermColor(colorNumber));
+}
+
+void ConsoleScreen::priv_makeColorDark(sf::Color& color) const
 {
 	color.r = static_cast<uint8_t>(m_darkAttributeMultiplier * color.r);
 	color.g = static_cast<uint8_t>(m_darkAttributeMultiplier * color.g);
 	color.b = static_cast<uint8_t>(m_darkAttributeMultiplier * color.b);
 }
 
+
+
+
+// CELL STORAGE
+
+ConsoleScreen::CellStorage::CellStorage(const bool packed)
+	: m_isPacked{ packed }
+	, m_cells()
+	, m_packedCells()
+	, m_editedCell(defaultCell)
+	, m_editedIndex{ noEditedCellIndex }
+{
+}
+
+void ConsoleScreen::CellStorage::setPacked(const bool packed)
+{
+	if (packed == m_isPacked)
+		return;
+
+	priv_packEditedCell();
+	if (packed)
+	{
+		m_packedCells.resize(m_cells.size());
+		for (std::size_t i{ 0u }; i < m_cells.size(); ++i)
+			m_packedCells[i] = priv_pack(m_cells[i]);
+		m_cells.clear();
+		m_cells.shrink_to_fit();
+	}
+	else
+	{
+		m_cells.resize(m_packedCells.size());
+		for (std::size_t i{ 0u }; i < m_packedCells.size(); ++i)
+			m_cells[i] = priv_unpack(m_packedCells[i]);
+		m_packedCells.clear();
+		m_packedCells.shrink_to_fit();
+	}
+	m_isPacked = packed;
+}
+
+bool ConsoleScreen::CellStorage::isPacked() const
+{
+	return m_isPacked;
+}
+
+std::size_t ConsoleScreen::CellStorage::size() const
+{
+	return m_isPacked ? m_packedCells.size() : m_cells.size();
+}
+
+bool ConsoleScreen::CellStorage::empty() const
+{
+	return size() == 0u;
+}
+
+void ConsoleScreen::CellStorage::clear()
+{
+	m_editedIndex = noEditedCellIndex;
+	m_cells.clear();
+	m_packedCells.clear();
+}
+
+void ConsoleScreen::CellStorage::resize(const std::size_t size, const Cell& cell)
+{
+	priv_packEditedCell();
+	if (m_isPacked)
+		m_packedCells.resize(size, priv_pack(cell));
+	else
+		m_cells.resize(size, cell);
+}
+
+void ConsoleScreen::CellStorage::pushBack(const Cell& cell)
+{
+	if (m_isPacked)
+		m_packedCells.push_back(priv_pack(cell));
+	else
+		m_cells.push_back(cell);
+}
+
+ConsoleScreen::Cell ConsoleScreen::CellStorage::get(const std::size_t index) const
+{
+	if (!m_isPacked)
+		return m_cells[index];
+	if (index == m_editedIndex)
+		return m_editedCell;
+	return priv_unpack(m_packedCells[index]);
+}
+
+void ConsoleScreen::CellStorage::set(const std::size_t index, const Cell& cell)
+{
+	if (!m_isPacked)
+	{
+		m_cells[index] = cell;
+		return;
+	}
+	if (index == m_editedIndex)
+		m_editedIndex = noEditedCellIndex;
+	priv_packEditedCell();
+	m_packedCells[index] = priv_pack(cell);
+}
+
+void ConsoleScreen::CellStorage::copy(const std::size_t destinationIndex, const std::size_t sourceIndex)
+{
+	if (!m_isPacked)
+	{
+		m_cells[destinationIndex] = m_cells[sourceIndex];
+		return;
+	}
+	priv_packEditedCell();
+	m_packedCells[destinationIndex] = m_packedCells[sourceIndex];
+}
+
+ConsoleScreen::Cell& ConsoleScreen::CellStorage::edit(const std::size_t index)
+{
+	if (!m_isPacked)
+		return m_cells[index];
+	if (index != m_editedIndex)
+	{
+		priv_packEditedCell();
+		m_editedCell = priv_unpack(m_packedCells[index]);
+		m_editedIndex = index;
+	}
+	return m_editedCell;
+}
+
+void ConsoleScreen::CellStorage::rotate(const std::size_t newFirstIndex)
+{
+	priv_packEditedCell();
+	if (m_isPacked)
+		std::rotate(m_packedCells.begin(), m_packedCells.begin() + newFirstIndex, m_packedCells.end());
+	else
+		std::rotate(m_cells.begin(), m_cells.begin() + newFirstIndex, m_cells.end());
+}
+
+std::size_t ConsoleScreen::CellStorage::getMemoryFootprint() const
+{
+	return m_isPacked ? m_packedCells.size() * sizeof(PackedCell) : m_cells.size() * sizeof(Cell);
+}
+
+void ConsoleScreen::CellStorage::priv_packEditedCell()
+{
+	if (m_editedIndex == noEditedCellIndex)
+		return;
+
+	m_packedCells[m_editedIndex] = priv_pack(m_editedCell);
+	m_editedIndex = noEditedCellIndex;
+}
+
+ConsoleScreen::CellStorage::PackedCell ConsoleScreen::CellStorage::priv_pack(const Cell& cell)
+{
+	PackedCell packedCell;
+	packedCell.value = static_cast<std::uint16_t>(cell.value);
+	packedCell.properties = static_cast<std::uint8_t>(cell.stretch);
+	if (cell.colors.foreground.id < 0)
+		packedCell.properties |= 0x04u;
+	if (cell.colors.background.id < 0)
+		packedCell.properties |= 0x08u;
+	if (cell.attributes.inverse)
+		packedCell.properties |= Affect::Inverse;
+	if (cell.attributes.dark)
+		packedCell.properties |= Affect::Dark;
+	if (cell.attributes.flipX)
+		packedCell.properties |= Affect::FlipX;
+	if (cell.attributes.flipY)
+		packedCell.properties |= Affect::FlipY;
+	packColorId(packedCell.foregroundColorId, cell.colors.foreground.id);
+	packColorId(packedCell.backgroundColorId, cell.colors.background.id);
+	return packedCell;
+}
+
+ConsoleScreen::Cell ConsoleScreen::CellStorage::priv_unpack(const PackedCell& packedCell)
+{
+	const long int foregroundColorId{ unpackColorId(packedCell.foregroundColorId) };
+	const long int backgroundColorId{ unpackColorId(packedCell.backgroundColorId) };
+	return
+	{
+		packedCell.value,
+		ColorPair(((packedCell.properties & 0x04u) != 0u) ? -foregroundColorId : foregroundColorId, ((packedCell.properties & 0x08u) != 0u) ? -backgroundColorId : backgroundColorId),
+		static_cast<StretchType>(packedCell.properties & 0x03u),
+		CellAttributes(packedCell.properties & Affect::Attribs)
+	};
+}
+
+
+
+
+
+// COMMAND QUEUE
+
+ConsoleScreen::CommandQueue::CommandQueue()
+	: m_stub{ nullptr, nullptr }
+	, m_head{ &m_stub }
+	, m_tail{ &m_stub }
+{
+}
+
+ConsoleScreen::CommandQueue::CommandQueue(const CommandQueue&)
+	: CommandQueue()
+{
+}
+
+ConsoleScreen::CommandQueue::~CommandQueue()
+{
+	while (Node* node{ priv_pop() })
+		delete node;
+}
+
+void ConsoleScreen::CommandQueue::push(Command command)
+{
+	priv_push(new Node{ nullptr, std::move(command) });
+}
+
+void ConsoleScreen::CommandQueue::process(ConsoleScreen& consoleScreen)
+{
+	// stops at a node that is still being linked by its producer; it is processed on the next call
+	while (Node* node{ priv_pop() })
+	{
+		const std::unique_ptr<Node> processedNode{ node };
+		processedNode->command(consoleScreen);
+	}
+}
+
+void ConsoleScreen::CommandQueue::priv_push(Node* const node)
+{
+	node->next.store(nullptr, std::memory_order_relaxed);
+	Node* const previousNode{ m_head.exchange(node, std::memory_order_acq_rel) };
+	previousNode->next.store(node, std::memory_order_release);
+}
+
+ConsoleScreen::CommandQueue::Node* ConsoleScreen::CommandQueue::priv_pop()
+{
+	Node* tail{ m_tail };
+	Node* next{ tail->next.load(std::memory_order_acquire) };
+	if (tail == &m_stub)
+	{
+		if (next == nullptr)
+			return nullptr;
+		m_tail = next;
+		tail = next;
+		next = next->next.load(std::memory_order_acquire);
+	}
+	if (next != nullptr)
+	{
+		m_tail = next;
+		return tail;
+	}
+	if (tail != m_head.load(std::memory_order_acquire))
+		return nullptr; // a producer has claimed the head but not yet linked it
+	priv_push(&m_stub);
+	next = tail->next.load(std::memory_order_acquire);
+	if (next == nullptr)
+		return nullptr;
+	m_tail = next;
+	return tail;
+}
+
 } // namespace selbaward
@@ -34,8 +34,17 @@
 #define SELBAWARD_CONSOLESCREEN_V2_HPP
 
 #include "Common.hpp"
-
-#include <unordered_map>
+#include "VertexSink.hpp"
+#include "VertexBufferCache.hpp"
+#include "Random.hpp"
+
+#include <array>
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 
 namespace sf
 {
@@ -183,6 +192,7 @@ public:
 	void setMode(sf::Vector2u mode); // "mode" is the number of cells used to fit the screen
 	sf::Vector2u getMode() const;
 	unsigned int getNumberOfCells() const;
+	std::size_t getCellMemoryFootprint() const; // number of bytes used to store the cells of the screen and of all buffers
 	sf::Vector2u getNumberOfTilesInTexture2d() const;
 	unsigned int getNumberOfTilesInTexture() const;
 	void setClearValue(unsigned int clearValue = 0u);
@@ -210,6 +220,9 @@ public:
 	void setScrollAutomatically(bool scroll);
 	void setWrapOnManualScroll(bool wrapOnManualScroll);
 	void setAddNewColorToPalette(bool addNewColorToPalette);
+	void setUseRowRingBuffer(bool useRowRingBuffer); // scrolling the entire screen moves a row offset instead of copying every cell
+	void setUsePackedCells(bool usePackedCells); // cells (including buffers) are stored compactly. values are limited to 16 bits and colour ids to 24 bits (plus sign)
+	void setUseVertexBuffer(bool useVertexBuffer, sf::VertexBuffer::Usage usage = sf::VertexBuffer::Usage::Stream); // main display is kept on the GPU and only updated cells are uploaded (drawn directly if vertex buffers are unavailable)
 	bool getThrowExceptions() const;
 	bool getUpdateAutomatically() const;
 	bool getShowCursor() const;
@@ -219,6 +232,9 @@ public:
 	bool getScrollAutomatically() const;
 	bool getWrapOnManualScroll() const;
 	bool getAddNewColorToPalette() const;
+	bool getUseRowRingBuffer() const;
+	bool getUsePackedCells() const;
+	bool getUseVertexBuffer() const;
 
 	// visual representation
 	void setSize(sf::Vector2f size);
@@ -230,13 +246,15 @@ public:
 	sf::Vector2f getCoordOfLocation(sf::Vector2f location) const;
 
 	// global
-	void update();
+	void update(); // regenerates only the cells that have changed since the previous update
+	unsigned int getNumberOfCellsUpdated() const; // number of cells regenerated by the most recent update (including an automatic update during draw)
 	void fill(Cell cell);
 	void clear(ColorPair colors);
 	void clear(Color backgroundColor);
 	void clear(ColorCommand colorCommand);
 	void clear();
 	void crash();
+	void setSeed(std::uint64_t seed); // seeds this console screen's random number generator (used by crash) for reproducible results
 
 	// stream
 	ConsoleScreen& operator<<(const std::string& string);
@@ -284,6 +302,15 @@ public:
 	void print(const Location& location, char character);
 	void print(const Location& location, const std::string& string);
 
+	// stream (text including ANSI/VT escape sequences)
+	void write(const char* data, std::size_t size); // prints text, interpreting control characters and escape sequences (SGR colours and attributes, cursor movement and erasing). sequences may be split across writes
+	void write(const std::string& string);
+
+	// queued commands (any number of threads may queue while the thread that owns the console screen processes the queue)
+	template <class... Items>
+	void queue(const Items&... items); // items are copied (C strings as std::string) and streamed (<<) together, in order, when the queue is processed. items queued by the same thread are processed in the order they were queued. other pointers cannot be queued
+	void processQueue(); // streams all queued items (e.g. just before drawing)
+
 	// stack printing (over- and under-printing)
 	void addOverAt(const Location& location, char character, sf::Vector2f offset = { 0.f, 0.f });
 	void addOverAt(const Location& location, const std::string& string, sf::Vector2f offset = { 0.f, 0.f });
@@ -309,6 +336,16 @@ public:
 	std::string read(unsigned int length);
 	std::string read(const Location& location);
 	std::string read(const Location& location, unsigned int length);
+	void read(std::string& string); // reads into an existing string (its capacity is reused)
+	void read(const Location& location, std::string& string);
+	std::size_t read(char* characters, std::size_t size); // reads into a caller-provided buffer (no terminating null is added). returns the number of characters read
+	std::size_t read(const Location& location, char* characters, std::size_t size);
+
+	// export (cells are exported row by row into contiguous arrays; their capacity is reused. returns the size of the region exported, which is the selection clipped to the screen)
+	sf::Vector2u exportValues(std::vector<std::uint32_t>& values) const;
+	sf::Vector2u exportValues(std::vector<std::uint32_t>& values, sf::IntRect selectionRectangle) const;
+	sf::Vector2u exportColors(std::vector<ColorPair>& colors) const;
+	sf::Vector2u exportColors(std::vector<ColorPair>& colors, sf::IntRect selectionRectangle) const;
 
 	// tabs
 	void setCursorTab(unsigned int tabSize);
@@ -358,6 +395,8 @@ public:
 	void addColorToPalette(sf::Color color);
 	void setPaletteColor(Color color, sf::Color newColor);
 	sf::Color getPaletteColor(Color color) const;
+	Color getClosestPaletteColor(sf::Color color) const; // closest palette colour (distance in RGB). in RGB mode, this is the colour's own id
+	std::vector<Color> getClosestPaletteColors(const std::vector<sf::Color>& colors) const; // closest palette colour for each colour
 	void setPaletteSize(unsigned long int size);
 	unsigned long int getPaletteSize() const;
 	void removePaletteColor(Color color);
@@ -381,13 +420,21 @@ public:
 	unsigned int getNumberOfBuffers() const;
 	sf::Vector2u getSizeOfBuffer(unsigned int index) const;
 
+	// scrollback (rows scrolled off the top of the screen by automatic scrolling, stored as packed cells)
+	void setScrollbackSize(unsigned int maximumNumberOfRows); // zero disables scrollback. if reduced, the oldest rows are discarded
+	unsigned int getScrollbackSize() const;
+	unsigned int getNumberOfScrollbackRows() const;
+	void clearScrollback();
+	void setScrollbackViewOffset(unsigned int numberOfRows); // number of rows the view is scrolled back (zero shows only the screen). clamped to the number of scrollback rows
+	unsigned int getScrollbackViewOffset() const;
+
 	// character mapping (to cell values)
 	void setMappedCharacter(char character, unsigned int value);
 	void setMappedCharacters(const std::string& characters, unsigned int initialValue);
 	void removeMappedCharacter(char character);
 	void removeMappedCharacters(const std::string& characters);
 	bool getIsMappedCharacter(char character) const;
-	unsigned int getMappedCharacter(char character) const;
+	unsigned int getMappedCharacter(char character) const; // throws std::out_of_range if the character is not mapped
 
 	// character mapping (to cursor commands)
 	void setMappedCursorCommandCharacter(char character, CursorCommand cursorCommand);
@@ -395,7 +442,7 @@ public:
 	void removeMappedCursorCommandCharacter(char character);
 	void removeMappedCursorCommandCharacters(const std::string& characters);
 	bool getIsMappedCursorCommandCharacter(char character) const;
-	CursorCommand getMappedCursorCommandCharacter(char character) const;
+	CursorCommand getMappedCursorCommandCharacter(char character) const; // throws std::out_of_range if the character is not mapped
 
 	// direct manipulation
 	void poke(unsigned int index, const Cell& cell);
@@ -406,10 +453,14 @@ public:
 	void poke(unsigned int index, bool attributeValue, const Affect& attributeMask);
 	void poke(unsigned int index, const CellAttributes& attributes);
 	Cell peek(unsigned int index) const;
-	Cell& cell(unsigned int index);
-	Cell& bufferCell(unsigned int bufferIndex, unsigned int cellIndex);
+	Cell& cell(unsigned int index); // cell is assumed to be modified and is updated with the next update. when using packed cells, the reference is only valid until the console screen is next modified
+	Cell& bufferCell(unsigned int bufferIndex, unsigned int cellIndex); // when using packed cells, the reference is only valid until the console screen is next modified
 	
 
+	// vertex sink
+	void appendVertices(VertexSink& sink, sf::RenderStates states = sf::RenderStates::Default) const; // submits what would be drawn to a sink instead of a render target
+	void appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform = sf::Transform::Identity) const; // appends what would be drawn as transformed triangles
+
 
 
 
@@ -464,6 +515,8 @@ private:
 		bool scrollAutomatically = true;
 		bool wrapOnManualScroll = false;
 		bool addNewColorToPalette = false; // if false, new colours are matched to nearest palette colour
+		bool useRowRingBuffer = false;
+		bool usePackedCells = false;
 	};
 	struct StateFlags
 	{
@@ -481,10 +534,50 @@ private:
 
 	const PrintProperties m_defaultPrintProperties;
 
+	// cell storage (either full cells or packed cells)
+	class CellStorage
+	{
+	public:
+		explicit CellStorage(bool packed = false);
+		void setPacked(bool packed);
+		bool isPacked() const;
+		std::size_t size() const;
+		bool empty() const;
+		void clear();
+		void resize(std::size_t size, const Cell& cell = Cell{});
+		void pushBack(const Cell& cell);
+		Cell get(std::size_t index) const;
+		void set(std::size_t index, const Cell& cell);
+		void copy(std::size_t destinationIndex, std::size_t sourceIndex);
+		Cell& edit(std::size_t index); // when packed, the reference is to a separate cell that is packed back on the next non-const access
+		void rotate(std::size_t newFirstIndex);
+		std::size_t getMemoryFootprint() const;
+
+	private:
+		struct PackedCell
+		{
+			std::uint16_t value;
+			std::uint8_t properties; // stretch type (bits 0-1), negative colour id flags (bit 2: foreground, bit 3: background) and attributes (bits 4-7; matches Affect)
+			std::uint8_t foregroundColorId[3]; // magnitude of colour id (little-endian)
+			std::uint8_t backgroundColorId[3]; // magnitude of colour id (little-endian)
+		};
+
+		bool m_isPacked;
+		std::vector<Cell> m_cells;
+		std::vector<PackedCell> m_packedCells;
+		Cell m_editedCell;
+		std::size_t m_editedIndex;
+
+		void priv_packEditedCell();
+		static PackedCell priv_pack(const Cell& cell);
+		static Cell priv_unpack(const PackedCell& packedCell);
+	};
+
 	// definition
 	using Cells = std::vector<Cell>;
-	Cells m_cells;
+	CellStorage m_cells; // stored by row starting from the row offset (cells of the top row of the screen are at the row offset)
 	sf::Vector2u m_mode;
+	unsigned int m_rowOffset;
 
 	// stack (under- and over-drawing) definition
 	std::vector<StackCell> m_overCells;
@@ -494,10 +587,18 @@ private:
 	struct Buffer
 	{
 		unsigned int width;
-		Cells cells;
+		CellStorage cells;
 	};
 	std::vector<Buffer> m_buffers;
 
+	// scrollback
+	CellStorage m_scrollbackCells; // rows in storage order, starting from the first row once full
+	unsigned int m_scrollbackSize; // maximum number of rows
+	unsigned int m_scrollbackFirstRow; // storage row of the oldest row
+	unsigned int m_numberOfScrollbackRows;
+	std::size_t m_numberOfRowsAddedToScrollback; // also identifies each row: the newest row is this minus one
+	unsigned int m_scrollbackViewOffset;
+
 	// cursor
 	CursorProperties m_cursor;
 
@@ -506,25 +607,95 @@ private:
 
 	// read
 	unsigned int m_readLength;
+
+	// stream (escape sequence parsing state persists between writes)
+	enum class StreamState
+	{
+		Text,
+		Escape,
+		ControlSequence,
+		String, // content is ignored until terminated
+		StringEscape
+	};
+	struct StreamParser
+	{
+		StreamState state;
+		std::vector<unsigned int> parameters;
+		bool isPrivateSequence;
+		Location savedLocation;
+		unsigned int addedAffectBitmask; // attributes that renditions added to the print properties' affect bitmask. removed again when those attributes are reset
+	};
+	StreamParser m_stream;
+
+	// command queue (lock-free; multiple producers, single consumer)
+	class CommandQueue
+	{
+	public:
+		using Command = std::function<void(ConsoleScreen&)>;
+
+		CommandQueue();
+		CommandQueue(const CommandQueue&); // a copy starts empty; queued commands are not shared
+		~CommandQueue();
+		void push(Command command);
+		void process(ConsoleScreen& consoleScreen);
+
+	private:
+		struct Node
+		{
+			std::atomic<Node*> next;
+			Command command;
+		};
+
+		Node m_stub; // always in the queue when it would otherwise be empty so that pushing never touches the consumer's end
+		std::atomic<Node*> m_head; // most recently pushed node (producers)
+		Node* m_tail; // next node to process (consumer)
+
+		void priv_push(Node* node);
+		Node* priv_pop();
+	};
+	CommandQueue m_commandQueue;
+	template <class Item>
+	using QueuedItem = std::conditional_t<std::is_same_v<std::decay_t<Item>, char*> || std::is_same_v<std::decay_t<Item>, const char*>, std::string, Item>; // C strings are copied so that they do not need to outlive the queue
 	
 	// colour palette
 	std::vector<sf::Color> m_palette;
+	mutable std::vector<std::vector<unsigned int>> m_paletteLookupRegions; // candidates for closest colour for each region of colour space (empty until required)
+	mutable bool m_isPaletteLookupValid;
 
-	// character map (character mapped to cell value)
-	std::unordered_map<char, unsigned int> m_characterMap;
+	// character map (character mapped to cell value). indexed by character as unsigned char. unmapped characters hold their own value so lookup never needs to test
+	std::array<unsigned int, 256u> m_characterMap;
+	std::array<bool, 256u> m_isCharacterMapped;
+	std::vector<std::int16_t> m_characterMapReverse; // character mapped to each cell value (-1 if none), for reading. sized to the largest mapped value (values above 16 bits are searched instead)
 
-	// character map for cursor commands (character mapped to a cursor command)
-	std::unordered_map<char, CursorCommand> m_characterMapCursorCommand;
+	// character map for cursor commands (character mapped to a cursor command). indexed by character as unsigned char
+	std::array<CursorCommand, 256u> m_characterMapCursorCommand;
+	std::array<bool, 256u> m_isCharacterMappedToCursorCommand;
 
 	// general setup values
 	unsigned int m_clearValue; // value to use when clearing a cell
 	float m_darkAttributeMultiplier; // sf::Color is multiplied by this amount when the cell's dark attribute is enabled
 
+	// update tracking
+	struct RowUpdateRange
+	{
+		unsigned int begin; // first column requiring update
+		unsigned int end; // one past the last column requiring update (no update required if not greater than begin)
+	};
+	mutable std::vector<RowUpdateRange> m_rowUpdateRanges;
+	mutable bool m_isStackUpdateRequired;
+	mutable unsigned int m_numberOfCellsUpdated;
+	mutable Random m_random;
+
 	// visual representation
-	std::vector<sf::Vertex> m_display;
-	std::vector<sf::Vertex> m_backgroundDisplay;
-	std::vector<sf::Vertex> m_overDisplay;
-	std::vector<sf::Vertex> m_underDisplay;
+	mutable std::vector<sf::Vertex> m_display;
+	mutable std::vector<sf::Vertex> m_backgroundDisplay;
+	mutable VertexBufferCache m_displayVertexBuffer;
+	mutable VertexBufferCache m_backgroundDisplayVertexBuffer;
+	mutable std::vector<sf::Vertex> m_overDisplay;
+	mutable std::vector<sf::Vertex> m_underDisplay;
+	mutable std::vector<sf::Vertex> m_scrollbackDisplay; // scrollback rows in view. each row's vertices are in the row (slot) of its identifier modulo the screen height
+	mutable std::vector<sf::Vertex> m_scrollbackBackgroundDisplay;
+	mutable std::vector<std::size_t> m_scrollbackDisplayRows; // identifier of the scrollback row held in each slot
 	sf::Vector2f m_size;
 	const sf::Texture* m_texture;
 	sf::Vector2u m_textureOffset;
@@ -532,12 +703,27 @@ private:
 	unsigned int m_numberOfTilesPerRow;
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
-	void priv_setVerticesFromCell(unsigned int index, int baseVertex = -1, bool overLayer = true);
-	void priv_updateCell(unsigned int index);
-	void priv_updateUnderCells();
-	void priv_updateOverCells();
+	void priv_drawRows(const std::vector<sf::Vertex>& vertices, VertexSink& sink, sf::RenderStates states, unsigned int firstRow, unsigned int numberOfRows, unsigned int displayRow) const;
+	void priv_setVerticesFromCell(unsigned int index, int baseVertex = -1, bool overLayer = true) const;
+	void priv_setVerticesFromCell(const Cell& cell, sf::Vector2u cellLocation, sf::Vector2f offset, sf::Vertex* pVertices, sf::Vertex* pBackgroundVertices, bool isCursor) const;
+	void priv_update() const;
+	void priv_updateScrollbackDisplay() const;
+	void priv_invalidateScrollbackDisplay();
+	void priv_addTopRowToScrollback();
+	void priv_markCellForUpdate(unsigned int index);
+	void priv_markAllCellsForUpdate();
+	void priv_markSelectionRectangleForUpdate(const sf::IntRect& selectionRectangle);
+	void priv_markCellsUsingPaletteRangeForUpdate(long int firstColorId, long int lastColorId);
+	void priv_markCellsWithDarkAttributeForUpdate();
+	void priv_updateUnderCells() const;
+	void priv_updateOverCells() const;
 	unsigned int priv_cellIndex(sf::Vector2u location) const;
 	sf::Vector2u priv_cellLocation(unsigned int index) const;
+	unsigned int priv_storageIndex(unsigned int index) const;
+	unsigned int priv_storageIndex(sf::Vector2u location) const;
+	void priv_offsetRows(int amount);
+	void priv_resetRowOffset();
+	CellStorage priv_getCellsInScreenOrder() const;
 	bool priv_isCellIndexInRange(unsigned int index) const;
 	bool priv_isCellLocationInRange(sf::Vector2u location) const;
 	bool priv_isScreenBufferIndexInRange(unsigned int index) const;
@@ -563,14 +749,23 @@ private:
 	Color priv_getRandomColor() const;
 	PrintProperties& priv_getCurrentPrintProperties();
 	PrintProperties& priv_getPrintProperties(const PrintType& printType);
-	Color priv_getModifiedColorFromColorPairUsingSpecifiedColorType(const ColorPair& colors, const ColorType& colorType);
-	Color priv_getModifiedColorFromCellUsingSpecifiedColorType(const unsigned int& cellIndex, const ColorType& colorType);
+	Color priv_getModifiedColorFromColorPairUsingSpecifiedColorType(const ColorPair& colors, const ColorType& colorType) const;
+	Color priv_getModifiedColorFromCellUsingSpecifiedColorType(const unsigned int& cellIndex, const ColorType& colorType) const;
 	Color& priv_getActiveColor();
 	Color& priv_getInactiveColor();
 	int priv_getIndexOfClosestPaletteColor(const sf::Color& color) const; // returns -1 if the palette is empty
-	std::string priv_read(unsigned int index, const bool unmapCharacters = true);
+	const std::vector<unsigned int>& priv_getPaletteLookupCandidates(const sf::Color& color) const;
+	std::size_t priv_read(unsigned int index, char* characters, std::size_t size, bool unmapCharacters = true);
+	sf::IntRect priv_getSelectionRectangleClippedToScreen(sf::IntRect selectionRectangle) const;
 	void priv_modifyCellUsingPrintProperties(unsigned int index, const PrintType& printType, const StretchType stretch);
-	void priv_makeColorDark(sf::Color& color);
+	void priv_modifyCellUsingPrintProperties(Cell& cell, const PrintProperties& printProperties, StretchType stretch) const;
+	void priv_printRun(const char* characters, std::size_t numberOfCharacters);
+	void priv_executeStreamControlCharacter(char character);
+	void priv_executeStreamControlSequence(char finalCharacter);
+	void priv_executeStreamSelectGraphicRendition();
+	void priv_eraseCellsForStream(unsigned int beginIndex, unsigned int endIndex);
+	Color priv_getColorFromStreamColorNumber(unsigned int colorNumber) const;
+	void priv_makeColorDark(sf::Color& color) const;
 };
 
 
@@ -761,7 +956,7 @@ inline void ConsoleScreen::setTexture(const sf::Texture& texture, const unsigned
 inline void ConsoleScreen::setDarkAttributeMultiplier(const float darkAttributeMultiplier)
 {
 	m_darkAttributeMultiplier = darkAttributeMultiplier;
-	update();
+	priv_markCellsWithDarkAttributeForUpdate();
 }
 
 inline float ConsoleScreen::getDarkAttributeMultiplier() const
@@ -829,6 +1024,26 @@ inline unsigned int ConsoleScreen::getNumberOfCells() const
 	return static_cast<unsigned int>(m_cells.size());
 }
 
+inline unsigned int ConsoleScreen::getScrollbackSize() const
+{
+	return m_scrollbackSize;
+}
+
+inline unsigned int ConsoleScreen::getNumberOfScrollbackRows() const
+{
+	return m_numberOfScrollbackRows;
+}
+
+inline unsigned int ConsoleScreen::getScrollbackViewOffset() const
+{
+	return m_scrollbackViewOffset;
+}
+
+inline unsigned int ConsoleScreen::getNumberOfCellsUpdated() const
+{
+	return m_numberOfCellsUpdated;
+}
+
 inline bool ConsoleScreen::getThrowExceptions() const
 {
 	return m_do.throwExceptions;
@@ -874,6 +1089,21 @@ inline bool ConsoleScreen::getAddNewColorToPalette() const
 	return m_do.addNewColorToPalette;
 }
 
+inline bool ConsoleScreen::getUseRowRingBuffer() const
+{
+	return m_do.useRowRingBuffer;
+}
+
+inline bool ConsoleScreen::getUsePackedCells() const
+{
+	return m_do.usePackedCells;
+}
+
+inline bool ConsoleScreen::getUseVertexBuffer() const
+{
+	return m_displayVertexBuffer.getEnabled();
+}
+
 inline int ConsoleScreen::getCursorValue() const
 {
 	return m_cursor.value;
@@ -929,6 +1159,21 @@ inline ConsoleScreen::ColorType ConsoleScreen::getColorType(const PrintType prin
 	return priv_getPrintProperties(printType).colorType;
 }
 
+template <class... Items>
+void ConsoleScreen::queue(const Items&... items)
+{
+	static_assert(!(std::is_pointer_v<QueuedItem<Items>> || ...), "Console Screen: queued items are processed later (possibly after a pointer is no longer valid) so pointers cannot be queued.");
+	if constexpr ((std::is_same_v<QueuedItem<Items>, Items> && ...))
+		m_commandQueue.push([items...](ConsoleScreen& consoleScreen) { (consoleScreen << ... << items); }); // captured directly so that small commands stay within std::function's own storage
+	else
+	{
+		m_commandQueue.push([queuedItems = std::tuple<QueuedItem<Items>...>(items...)](ConsoleScreen& consoleScreen)
+		{
+			std::apply([&](const auto&... items) { (consoleScreen << ... << items); }, queuedItems);
+		});
+	}
+}
+
 inline void ConsoleScreen::setCursorTab(const unsigned int tabSize)
 {
 	m_tabSize = tabSize;
@@ -942,6 +1187,7 @@ inline unsigned int ConsoleScreen::getCursorTab() const
 inline void ConsoleScreen::addColorToPalette(const sf::Color color)
 {
 	m_palette.emplace_back(color);
+	m_isPaletteLookupValid = false;
 }
 
 inline unsigned long int ConsoleScreen::getPaletteSize() const
@@ -959,22 +1205,12 @@ inline unsigned int ConsoleScreen::getNumberOfBuffers() const
 	return static_cast<unsigned int>(m_buffers.size());
 }
 
-inline void ConsoleScreen::setMappedCharacter(const char character, const unsigned int value)
-{
-	m_characterMap[character] = value;
-}
-
 inline void ConsoleScreen::setMappedCharacters(const std::string& characters, unsigned int initialValue)
 {
 	for (auto& character : characters)
 		setMappedCharacter(character, initialValue++);
 }
 
-inline void ConsoleScreen::removeMappedCharacter(const char character)
-{
-	m_characterMap.erase(character);
-}
-
 inline void ConsoleScreen::removeMappedCharacters(const std::string& characters)
 {
 	for (auto& character : characters)
@@ -983,17 +1219,20 @@ inline void ConsoleScreen::removeMappedCharacters(const std::string& characters)
 
 inline bool ConsoleScreen::getIsMappedCharacter(const char character) const
 {
-	return m_characterMap.find(character) != m_characterMap.end();
+	return m_isCharacterMapped[static_cast<unsigned char>(character)];
 }
 
 inline unsigned int ConsoleScreen::getMappedCharacter(const char character) const
 {
-	return m_characterMap.at(character);
+	if (!getIsMappedCharacter(character))
+		throw std::out_of_range("Console Screen: Character is not mapped.");
+	return m_characterMap[static_cast<unsigned char>(character)];
 }
 
 inline void ConsoleScreen::setMappedCursorCommandCharacter(const char character, const CursorCommand cursorCommand)
 {
-	m_characterMapCursorCommand[character] = cursorCommand;
+	m_characterMapCursorCommand[static_cast<unsigned char>(character)] = cursorCommand;
+	m_isCharacterMappedToCursorCommand[static_cast<unsigned char>(character)] = true;
 }
 
 inline void ConsoleScreen::setMappedCursorCommandCharacters(const std::string& characters, const std::vector<CursorCommand>& cursorCommands)
@@ -1004,7 +1243,8 @@ inline void ConsoleScreen::setMappedCursorCommandCharacters(const std::string& c
 
 inline void ConsoleScreen::removeMappedCursorCommandCharacter(const char character)
 {
-	m_characterMapCursorCommand.erase(character);
+	m_characterMapCursorCommand[static_cast<unsigned char>(character)] = CursorCommand::None;
+	m_isCharacterMappedToCursorCommand[static_cast<unsigned char>(character)] = false;
 }
 
 inline void ConsoleScreen::removeMappedCursorCommandCharacters(const std::string& characters)
@@ -1015,12 +1255,14 @@ inline void ConsoleScreen::removeMappedCursorCommandCharacters(const std::string
 
 inline bool ConsoleScreen::getIsMappedCursorCommandCharacter(const char character) const
 {
-	return m_characterMapCursorCommand.find(character) != m_characterMapCursorCommand.end();
+	return m_isCharacterMappedToCursorCommand[static_cast<unsigned char>(character)];
 }
 
 inline ConsoleScreen::CursorCommand ConsoleScreen::getMappedCursorCommandCharacter(const char character) const
 {
-	return m_characterMapCursorCommand.at(character);
+	if (!getIsMappedCursorCommandCharacter(character))
+		throw std::out_of_range("Console Screen: Character is not mapped to a cursor command.");
+	return m_characterMapCursorCommand[static_cast<unsigned char>(character)];
 }
 
 } // namespace selbaward
@@ -254,15 +254,27 @@ void GallerySprite::operator-=(const std::size_t exhibits)
 	priv_updateVertices();
 }
 
+void GallerySprite::appendVertices(VertexSink& sink, sf::RenderStates states) const
+{
+	states.texture = m_pTexture;
+	states.transform *= getTransform();
+	sink.append(&m_vertices.front(), numberOfVertices, primitiveType, states);
+}
+
+void GallerySprite::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
+{
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
+
 
 
 // PRIVATE
 
 void GallerySprite::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	states.texture = m_pTexture;
-	states.transform *= getTransform();
-	target.draw(&m_vertices.front(), numberOfVertices, primitiveType, states);
+	RenderTargetVertexSink sink{ target };
+	appendVertices(sink, states);
 }
 
 void GallerySprite::priv_updateVertices()
@@ -34,6 +34,7 @@
 #define SELBAWARD_GALLERYSPRITE_HPP
 
 #include "Common.hpp"
+#include "VertexSink.hpp"
 #include <SFML/Graphics/Texture.hpp>
 
 namespace selbaward
@@ -90,6 +91,10 @@ public:
 	void operator+=(std::size_t numberOfExhibits);
 	void operator-=(std::size_t numberOfExhibits);
 
+	// vertex sink
+	void appendVertices(VertexSink& sink, sf::RenderStates states = sf::RenderStates::Default) const; // submits what would be drawn to a sink instead of a render target
+	void appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform = sf::Transform::Identity) const; // appends what would be drawn as transformed triangles
+
 private:
 	const sf::Texture* m_pTexture;
 	std::vector<sf::Vertex> m_vertices;
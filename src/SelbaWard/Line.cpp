@@ -197,22 +197,31 @@ sf::FloatRect Line::getTextureRect() const
 	return m_textureRect;
 }
 
+void Line::appendVertices(VertexSink& sink, sf::RenderStates states) const
+{
+	states.transform *= getTransform();
+	states.texture = nullptr;
+	const sf::VertexArray& vertices{ isThick() ? m_quad : m_vertices };
+	if (isThick() && (m_texture != nullptr))
+		states.texture = m_texture;
+	if (vertices.getVertexCount() > 0u)
+		sink.append(&vertices[0u], vertices.getVertexCount(), vertices.getPrimitiveType(), states);
+}
+
+void Line::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
+{
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
+
 
 
 // PRIVATE
 
 void Line::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	states.transform *= getTransform();
-	states.texture = nullptr;
-	if (isThick())
-	{
-		if (m_texture != nullptr)
-			states.texture = m_texture;
-		target.draw(m_quad, states);
-	}
-	else
-		target.draw(m_vertices, states);
+	RenderTargetVertexSink sink{ target };
+	appendVertices(sink, states);
 }
 
 bool Line::isThick() const
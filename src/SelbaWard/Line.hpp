@@ -34,6 +34,7 @@
 #define SELBAWARD_LINE_HPP
 
 #include "Common.hpp"
+#include "VertexSink.hpp"
 
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/Texture.hpp>
@@ -66,6 +67,10 @@ public:
 	void setTextureRect(const sf::FloatRect& textureRect);
 	sf::FloatRect getTextureRect() const;
 
+	// vertex sink
+	void appendVertices(VertexSink& sink, sf::RenderStates states = sf::RenderStates::Default) const; // submits what would be drawn to a sink instead of a render target
+	void appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform = sf::Transform::Identity) const; // appends what would be drawn as transformed triangles
+
 
 
 
@@ -236,15 +236,27 @@ bool NinePatch::isPointInsideTransformedContentArea(const sf::Vector2f point) co
 	return getLocalContentArea().contains(getInverseTransform().transformPoint(point));
 }
 
+void NinePatch::appendVertices(VertexSink& sink, sf::RenderStates states) const
+{
+	states.texture = m_texture;
+	states.transform *= getTransform();
+	sink.append(m_vertices.data(), 22u, sf::PrimitiveType::TriangleStrip, states);
+}
+
+void NinePatch::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
+{
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
+
 
 
 // PRIVATE
 
 void NinePatch::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	states.texture = m_texture;
-	states.transform *= getTransform();
-	target.draw(m_vertices.data(), 22u, sf::PrimitiveType::TriangleStrip, states);
+	RenderTargetVertexSink sink{ target };
+	appendVertices(sink, states);
 }
 
 void NinePatch::priv_updateVertices()
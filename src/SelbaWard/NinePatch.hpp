@@ -34,6 +34,7 @@
 #define SELBAWARD_NINEPATCH_HPP
 
 #include "Common.hpp"
+#include "VertexSink.hpp"
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Rect.hpp>
 
@@ -59,6 +60,10 @@ public:
 	sf::FloatRect getGlobalContentArea() const; // final area. note that this takes into account all transformations so any rotation may make the return value much less useful
 	bool isPointInsideTransformedContentArea(sf::Vector2f point) const;
 
+	// vertex sink
+	void appendVertices(VertexSink& sink, sf::RenderStates states = sf::RenderStates::Default) const; // submits what would be drawn to a sink instead of a render target
+	void appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform = sf::Transform::Identity) const; // appends what would be drawn as transformed triangles
+
 private:
 	std::vector<sf::Vertex> m_vertices;
 	const sf::Texture* m_texture;
@@ -133,16 +133,28 @@ sf::FloatRect PieChart::getGlobalBounds() const
 	return{ topLeft, bottomRight - topLeft };
 }
 
+void PieChart::appendVertices(VertexSink& sink, sf::RenderStates states) const
+{
+	states.transform *= getTransform();
+
+	if (!m_vertices.empty())
+		sink.append(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+}
+
+void PieChart::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
+{
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
+
 
 
 // PRIVATE
 
 void PieChart::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	states.transform *= getTransform();
-
-	if (!m_vertices.empty())
-		target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+	RenderTargetVertexSink sink{ target };
+	appendVertices(sink, states);
 }
 
 } // namespace selbaward
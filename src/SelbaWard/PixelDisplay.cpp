@@ -32,27 +32,45 @@
 
 #include "PixelDisplay.hpp"
 
-#include <random>
-#include <functional>
+#include <SFML/Graphics/Shader.hpp>
 #include <assert.h>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
 
 namespace
 {
 
-std::mt19937 randomGenerator{};
-const std::uniform_int_distribution<unsigned short int> randomDistribution(0u, 255u);
-std::function <unsigned short int()> getRandomByteValue{};
+static_assert(sizeof(sf::Color) == 4u, "sf::Color must be tightly packed RGBA to be uploaded to a texture directly");
 
-inline void randomSeed()
+template <class IndexType>
+inline bool isPaletteSizeSupported(const std::size_t numberOfColors) // every colour must be representable by the pixel index type
 {
-	std::random_device rd{};
-	randomGenerator.seed(rd());
-	getRandomByteValue = std::bind(randomDistribution, randomGenerator);
+	return (numberOfColors == 0u) || ((numberOfColors - 1u) <= std::numeric_limits<IndexType>::max());
 }
 
-inline unsigned char randomByte()
+constexpr std::size_t paletteTextureWidth{ 256u };
+constexpr std::size_t maximumShaderPaletteSize{ 65536u }; // indices are encoded in two bytes of each texel
+bool isPaletteShaderLoaded{ false };
+sf::Shader paletteShader;
+
+const std::string paletteFragmentShaderCode
+{
+	"#version 110\n\nuniform sampler2D indices;\nuniform sampler2D palette;\nuniform float paletteRows;\n\n"
+	"void main()\n{\nvec4 index = texture2D(indices, gl_TexCoord[0].xy);\n"
+	"vec2 paletteCoord = vec2((floor(index.r * 255.0 + 0.5) + 0.5) / 256.0, (floor(index.g * 255.0 + 0.5) + 0.5) / paletteRows);\n"
+	"gl_FragColor = gl_Color * texture2D(palette, paletteCoord);\n}\n"
+};
+
+void loadPaletteShader()
+{
+	if (!isPaletteShaderLoaded && paletteShader.loadFromMemory(paletteFragmentShaderCode, sf::Shader::Type::Fragment))
+		isPaletteShaderLoaded = true;
+}
+
+inline sf::Color encodeIndex(const std::size_t index)
 {
-	return static_cast<unsigned char>(getRandomByteValue());
+	return{ static_cast<std::uint8_t>(index & 0xFFu), static_cast<std::uint8_t>((index >> 8u) & 0xFFu), 0u, 255u };
 }
 
 template <class T>
@@ -60,8 +78,7 @@ void shiftVectorDown(std::vector<T>& vector, const std::size_t amount, const std
 {
 	if ((numberOfElements == 0u) || ((startIndex + numberOfElements) > vector.size()))
 		numberOfElements = vector.size() - startIndex;
-	for (std::size_t i{ 0u }; i < (numberOfElements - amount); ++i)
-		vector[startIndex + i] = vector[startIndex + i + amount];
+	std::copy(vector.begin() + startIndex + amount, vector.begin() + startIndex + numberOfElements, vector.begin() + startIndex);
 }
 
 template <class T>
@@ -69,8 +86,7 @@ void shiftVectorUp(std::vector<T>& vector, const std::size_t amount, const std::
 {
 	if ((numberOfElements == 0u) || ((startIndex + numberOfElements) > vector.size()))
 		numberOfElements = vector.size() - startIndex;
-	for (std::size_t i{ 0u }; i < (numberOfElements - amount); ++i)
-		vector[startIndex + numberOfElements - i - 1u] = vector[startIndex + numberOfElements - (i + amount) - 1u];
+	std::copy_backward(vector.begin() + startIndex, vector.begin() + startIndex + numberOfElements - amount, vector.begin() + startIndex + numberOfElements);
 }
 
 template <class T>
@@ -78,13 +94,7 @@ void shiftVectorWrapDown(std::vector<T>& vector, const std::size_t amount, const
 {
 	if ((numberOfElements == 0u) || ((startIndex + numberOfElements) > vector.size()))
 		numberOfElements = vector.size() - startIndex;
-	std::vector<T> tempPixels(amount);
-	for (std::size_t i{ 0u }; i < amount; ++i)
-		tempPixels[i] = vector[startIndex + i];
-	for (std::size_t i{ 0u }; i < (numberOfElements - amount); ++i)
-		vector[startIndex + i] = vector[startIndex + i + amount];
-	for (std::size_t i{ 0u }; i < amount; ++i)
-		vector[startIndex + numberOfElements - amount + i] = tempPixels[i];
+	std::rotate(vector.begin() + startIndex, vector.begin() + startIndex + amount, vector.begin() + startIndex + numberOfElements);
 }
 
 template <class T>
@@ -92,13 +102,7 @@ void shiftVectorWrapUp(std::vector<T>& vector, const std::size_t amount, const s
 {
 	if ((numberOfElements == 0u) || ((startIndex + numberOfElements) > vector.size()))
 		numberOfElements = vector.size() - startIndex;
-	std::vector<T> tempPixels(amount);
-	for (std::size_t i{ 0u }; i < amount; ++i)
-		tempPixels[i] = vector[startIndex + numberOfElements - amount + i];
-	for (std::size_t i{ 0u }; i < (numberOfElements - amount); ++i)
-		vector[startIndex + numberOfElements - i - 1u] = vector[startIndex + numberOfElements - (i + amount) - 1u];
-	for (std::size_t i{ 0u }; i < amount; ++i)
-		vector[startIndex + i] = tempPixels[i];
+	std::rotate(vector.begin() + startIndex, vector.begin() + startIndex + numberOfElements - amount, vector.begin() + startIndex + numberOfElements);
 }
 
 } // namespace
@@ -106,101 +110,129 @@ void shiftVectorWrapUp(std::vector<T>& vector, const std::size_t amount, const s
 namespace selbaward
 {
 
-PixelDisplay::PixelDisplay()
+template <class IndexType>
+BasicPixelDisplay<IndexType>::BasicPixelDisplay()
 	: m_resolution{ 320u, 240u }
 	, m_size{ 640.f, 480.f }
 	, m_palette(16u)
 	, m_pixels{}
 	, m_vertices{}
+	, m_vertexBuffer{}
+	, m_renderMode{ RenderMode::Vertices }
+	, m_isSmooth{ false }
+	, m_textureColors{}
+	, m_texture{}
+	, m_useShader{ false }
+	, m_paletteTexture{}
+	, m_isPaletteTextureUpdateRequired{ true }
+	, m_dirtyRows{}
+	, m_dirtyRowsBegin{ 0u }
+	, m_dirtyRowsEnd{ 0u }
+	, m_random{}
 	, m_buffers{}
 {
 	priv_updateVertices();
 	m_pixels.resize(m_resolution.x * m_resolution.y);
 	for (auto& pixel : m_pixels)
 		pixel = 0u;
-	priv_updatePixels();
+	priv_setAllDirty();
 }
 
-void PixelDisplay::setSize(const sf::Vector2f size)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setSize(const sf::Vector2f size)
 {
 	m_size = size;
 	priv_updateVertices();
 }
 
-void PixelDisplay::setResolution(const sf::Vector2<std::size_t> resolution)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setResolution(const sf::Vector2<std::size_t> resolution)
 {
 	m_resolution = resolution;
 	m_pixels.resize(m_resolution.x * m_resolution.y);
 	priv_updateVertices();
+	priv_setAllDirty();
 }
 
-void PixelDisplay::setPaletteSize(const std::size_t numberOfColors)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setPaletteSize(const std::size_t numberOfColors)
 {
+	assert(isPaletteSizeSupported<IndexType>(numberOfColors));
 	m_palette.resize(numberOfColors);
+	m_isPaletteTextureUpdateRequired = true;
 }
 
-void PixelDisplay::setColor(const std::size_t color, const sf::Color rgb)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setColor(const std::size_t color, const sf::Color rgb)
 {
 	assert(color < m_palette.size());
 	m_palette[color] = rgb;
-	priv_updatePixels();
+	priv_setPaletteChanged();
 }
 
-void PixelDisplay::setPixel(const std::size_t index, const std::size_t color)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setPixel(const std::size_t index, const std::size_t color)
 {
 	assert(index < m_pixels.size());
-	m_pixels[index] = color;
-	priv_updatePixel(index);
+	m_pixels[index] = static_cast<IndexType>(color);
+	priv_setIndicesDirty(index, 1u);
 }
 
-void PixelDisplay::setPixels(const char* colors, const std::size_t numberOfColors, const std::size_t startIndex)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setPixels(const char* colors, const std::size_t numberOfColors, const std::size_t startIndex)
 {
 	assert(startIndex < m_pixels.size());
 	setPixels(reinterpret_cast<const unsigned char*>(colors), numberOfColors, startIndex);
 }
 
-void PixelDisplay::getPixels(char* colors, const std::size_t numberOfColors, const std::size_t startIndex) const
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::getPixels(char* colors, const std::size_t numberOfColors, const std::size_t startIndex) const
 {
 	assert(startIndex < m_pixels.size());
 	getPixels(reinterpret_cast<unsigned char*>(colors), numberOfColors, startIndex);
 }
 
-void PixelDisplay::fill(const std::size_t color)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::fill(const std::size_t color)
 {
 	assert(color < m_palette.size());
-	for (auto& pixel : m_pixels)
-		pixel = color;
-	priv_updatePixels();
+	std::fill(m_pixels.begin(), m_pixels.end(), static_cast<IndexType>(color));
+	priv_setAllDirty();
 }
 
-void PixelDisplay::clear()
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::clear()
 {
 	assert(m_palette.size() != 0u);
 	fill(0u);
 }
 
-void PixelDisplay::randomize()
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::randomize()
 {
 	for (auto& pixel : m_pixels)
-		pixel = priv_getRandomColor();
-	priv_updatePixels();
+		pixel = static_cast<IndexType>(priv_getRandomColor());
+	priv_setAllDirty();
 }
 
-void PixelDisplay::shiftLeft(const std::size_t amount, const std::size_t startIndex, const std::size_t numberOfPixels)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::shiftLeft(const std::size_t amount, const std::size_t startIndex, const std::size_t numberOfPixels)
 {
 	assert(startIndex < m_pixels.size());
 	shiftVectorWrapDown(m_pixels, amount, startIndex, numberOfPixels);
-	priv_updatePixels();
+	priv_setIndicesDirty(startIndex, numberOfPixels);
 }
 
-void PixelDisplay::shiftRight(const std::size_t amount, const std::size_t startIndex, const std::size_t numberOfPixels)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::shiftRight(const std::size_t amount, const std::size_t startIndex, const std::size_t numberOfPixels)
 {
 	assert(startIndex < m_pixels.size());
 	shiftVectorWrapUp(m_pixels, amount, startIndex, numberOfPixels);
-	priv_updatePixels();
+	priv_setIndicesDirty(startIndex, numberOfPixels);
 }
 
-void PixelDisplay::scrollUp(const std::size_t color, const std::size_t amount, sf::IntRect selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::scrollUp(const std::size_t color, const std::size_t amount, sf::IntRect selectionRectangle)
 {
 	assert(color < m_palette.size());
 	assert(selectionRectangle.position.x < static_cast<int>(m_resolution.x));
@@ -210,18 +242,19 @@ void PixelDisplay::scrollUp(const std::size_t color, const std::size_t amount, s
 	if (selectionRectangle.size.y == 0u)
 		selectionRectangle.size.y = static_cast<int>(m_resolution.y - selectionRectangle.position.y);
 	sf::Rect<std::size_t> rectangle(selectionRectangle);
-	for (std::size_t y{ 0u }; y < rectangle.size.y; ++y)
+	const auto firstPixel{ m_pixels.begin() + rectangle.position.y * m_resolution.x + rectangle.position.x };
+	for (std::size_t y{ 0u }; y < rectangle.size.y - 1u; ++y)
 	{
-		for (std::size_t x{ 0u }; x < rectangle.size.x; ++x)
-		{
-			const std::size_t index{ (rectangle.position.y + y) * m_resolution.x + rectangle.position.x + x };
-			m_pixels[index] = (y == rectangle.size.y - 1u) ? color : m_pixels[index + m_resolution.x];
-		}
+		const auto row{ firstPixel + y * m_resolution.x };
+		std::copy(row + m_resolution.x, row + m_resolution.x + rectangle.size.x, row);
 	}
-	priv_updatePixels();
+	const auto lastRow{ firstPixel + (rectangle.size.y - 1u) * m_resolution.x };
+	std::fill(lastRow, lastRow + rectangle.size.x, static_cast<IndexType>(color));
+	priv_setDirty(sf::Rect<std::size_t>(selectionRectangle));
 }
 
-void PixelDisplay::scrollDown(const std::size_t color, const std::size_t amount, sf::IntRect selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::scrollDown(const std::size_t color, const std::size_t amount, sf::IntRect selectionRectangle)
 {
 	assert(color < m_palette.size());
 	assert(selectionRectangle.position.x < static_cast<int>(m_resolution.x));
@@ -231,18 +264,18 @@ void PixelDisplay::scrollDown(const std::size_t color, const std::size_t amount,
 	if (selectionRectangle.size.y == 0u)
 		selectionRectangle.size.y = static_cast<int>(m_resolution.y - selectionRectangle.position.y);
 	sf::Rect<std::size_t> rectangle(selectionRectangle);
-	for (std::size_t y{ 0u }; y < rectangle.size.y; ++y)
+	const auto firstPixel{ m_pixels.begin() + rectangle.position.y * m_resolution.x + rectangle.position.x };
+	for (std::size_t y{ rectangle.size.y - 1u }; y > 0u; --y)
 	{
-		for (std::size_t x{ 0u }; x < rectangle.size.x; ++x)
-		{
-			const std::size_t index{ (rectangle.position.y + rectangle.size.y - y - 1u) * m_resolution.x + rectangle.position.x + x };
-			m_pixels[index] = (y == rectangle.size.y - 1u) ? color : m_pixels[index - m_resolution.x];
-		}
+		const auto row{ firstPixel + y * m_resolution.x };
+		std::copy(row - m_resolution.x, row - m_resolution.x + rectangle.size.x, row);
 	}
-	priv_updatePixels();
+	std::fill(firstPixel, firstPixel + rectangle.size.x, static_cast<IndexType>(color));
+	priv_setDirty(sf::Rect<std::size_t>(selectionRectangle));
 }
 
-void PixelDisplay::scrollLeft(const std::size_t color, const std::size_t amount, sf::IntRect selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::scrollLeft(const std::size_t color, const std::size_t amount, sf::IntRect selectionRectangle)
 {
 	assert(color < m_palette.size());
 	assert(selectionRectangle.position.x < static_cast<int>(m_resolution.x));
@@ -256,12 +289,13 @@ void PixelDisplay::scrollLeft(const std::size_t color, const std::size_t amount,
 	{
 		const std::size_t firstPixelIndex{ (rectangle.position.y + y) * m_resolution.x + rectangle.position.x };
 		shiftVectorDown(m_pixels, amount, firstPixelIndex, rectangle.size.x);
-		m_pixels[firstPixelIndex + rectangle.size.x - 1u] = color;
+		m_pixels[firstPixelIndex + rectangle.size.x - 1u] = static_cast<IndexType>(color);
 	}
-	priv_updatePixels();
+	priv_setDirty(sf::Rect<std::size_t>(selectionRectangle));
 }
 
-void PixelDisplay::scrollRight(const std::size_t color, const std::size_t amount, sf::IntRect selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::scrollRight(const std::size_t color, const std::size_t amount, sf::IntRect selectionRectangle)
 {
 	assert(color < m_palette.size());
 	assert(selectionRectangle.position.x < static_cast<int>(m_resolution.x));
@@ -275,12 +309,13 @@ void PixelDisplay::scrollRight(const std::size_t color, const std::size_t amount
 	{
 		const std::size_t firstPixelIndex{ (rectangle.position.y + y) * m_resolution.x + rectangle.position.x };
 		shiftVectorUp(m_pixels, amount, firstPixelIndex, rectangle.size.x);
-		m_pixels[firstPixelIndex] = color;
+		m_pixels[firstPixelIndex] = static_cast<IndexType>(color);
 	}
-	priv_updatePixels();
+	priv_setDirty(sf::Rect<std::size_t>(selectionRectangle));
 }
 
-void PixelDisplay::scrollWrapUp(const std::size_t amount, sf::IntRect selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::scrollWrapUp(const std::size_t amount, sf::IntRect selectionRectangle)
 {
 	assert(selectionRectangle.position.x < static_cast<int>(m_resolution.x));
 	assert(selectionRectangle.position.y < static_cast<int>(m_resolution.y));
@@ -289,21 +324,19 @@ void PixelDisplay::scrollWrapUp(const std::size_t amount, sf::IntRect selectionR
 	if (selectionRectangle.size.y == 0u)
 		selectionRectangle.size.y = static_cast<int>(m_resolution.y - selectionRectangle.position.y);
 	sf::Rect<std::size_t> rectangle(selectionRectangle);
-	std::vector<std::size_t> tempRow(rectangle.size.x);
-	for (std::size_t x{ 0u }; x < rectangle.size.x; ++x)
-		tempRow[x] = m_pixels[rectangle.position.y * m_resolution.x + rectangle.position.x + x];
-	for (std::size_t y{ 0u }; y < rectangle.size.y; ++y)
+	const auto firstPixel{ m_pixels.begin() + rectangle.position.y * m_resolution.x + rectangle.position.x };
+	const std::vector<IndexType> tempRow(firstPixel, firstPixel + rectangle.size.x);
+	for (std::size_t y{ 0u }; y < rectangle.size.y - 1u; ++y)
 	{
-		for (std::size_t x{ 0u }; x < rectangle.size.x; ++x)
-		{
-			const std::size_t index{ (rectangle.position.y + y) * m_resolution.x + rectangle.position.x + x };
-			m_pixels[index] = (y == rectangle.size.y - 1u) ? tempRow[x] : m_pixels[index + m_resolution.x];
-		}
+		const auto row{ firstPixel + y * m_resolution.x };
+		std::copy(row + m_resolution.x, row + m_resolution.x + rectangle.size.x, row);
 	}
-	priv_updatePixels();
+	std::copy(tempRow.begin(), tempRow.end(), firstPixel + (rectangle.size.y - 1u) * m_resolution.x);
+	priv_setDirty(sf::Rect<std::size_t>(selectionRectangle));
 }
 
-void PixelDisplay::scrollWrapDown(const std::size_t amount, sf::IntRect selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::scrollWrapDown(const std::size_t amount, sf::IntRect selectionRectangle)
 {
 	assert(selectionRectangle.position.x < static_cast<int>(m_resolution.x));
 	assert(selectionRectangle.position.y < static_cast<int>(m_resolution.y));
@@ -312,21 +345,20 @@ void PixelDisplay::scrollWrapDown(const std::size_t amount, sf::IntRect selectio
 	if (selectionRectangle.size.y == 0u)
 		selectionRectangle.size.y = static_cast<int>(m_resolution.y - selectionRectangle.position.y);
 	sf::Rect<std::size_t> rectangle(selectionRectangle);
-	std::vector<std::size_t> tempRow(rectangle.size.x);
-	for (std::size_t x{ 0u }; x < rectangle.size.x; ++x)
-		tempRow[x] = m_pixels[(rectangle.position.y + rectangle.size.y - 1u) * m_resolution.x + rectangle.position.x + x];
-	for (std::size_t y{ 0u }; y < rectangle.size.y; ++y)
+	const auto firstPixel{ m_pixels.begin() + rectangle.position.y * m_resolution.x + rectangle.position.x };
+	const auto lastRow{ firstPixel + (rectangle.size.y - 1u) * m_resolution.x };
+	const std::vector<IndexType> tempRow(lastRow, lastRow + rectangle.size.x);
+	for (std::size_t y{ rectangle.size.y - 1u }; y > 0u; --y)
 	{
-		for (std::size_t x{ 0u }; x < rectangle.size.x; ++x)
-		{
-			const std::size_t index{ (rectangle.position.y + rectangle.size.y - y - 1u) * m_resolution.x + rectangle.position.x + x };
-			m_pixels[index] = (y == rectangle.size.y - 1u) ? tempRow[x] : m_pixels[index - m_resolution.x];
-		}
+		const auto row{ firstPixel + y * m_resolution.x };
+		std::copy(row - m_resolution.x, row - m_resolution.x + rectangle.size.x, row);
 	}
-	priv_updatePixels();
+	std::copy(tempRow.begin(), tempRow.end(), firstPixel);
+	priv_setDirty(sf::Rect<std::size_t>(selectionRectangle));
 }
 
-void PixelDisplay::scrollWrapLeft(const std::size_t amount, sf::IntRect selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::scrollWrapLeft(const std::size_t amount, sf::IntRect selectionRectangle)
 {
 	assert(selectionRectangle.position.x < static_cast<int>(m_resolution.x));
 	assert(selectionRectangle.position.y < static_cast<int>(m_resolution.y));
@@ -337,10 +369,11 @@ void PixelDisplay::scrollWrapLeft(const std::size_t amount, sf::IntRect selectio
 	sf::Rect<std::size_t> rectangle(selectionRectangle);
 	for (std::size_t y{ 0u }; y < rectangle.size.y; ++y)
 		shiftVectorWrapDown(m_pixels, amount, (rectangle.position.y + y) * m_resolution.x + rectangle.position.x, rectangle.size.x);
-	priv_updatePixels();
+	priv_setDirty(sf::Rect<std::size_t>(selectionRectangle));
 }
 
-void PixelDisplay::scrollWrapRight(const std::size_t amount, sf::IntRect selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::scrollWrapRight(const std::size_t amount, sf::IntRect selectionRectangle)
 {
 	assert(selectionRectangle.position.x < static_cast<int>(m_resolution.x));
 	assert(selectionRectangle.position.y < static_cast<int>(m_resolution.y));
@@ -350,91 +383,295 @@ void PixelDisplay::scrollWrapRight(const std::size_t amount, sf::IntRect selecti
 		selectionRectangle.size.y = static_cast<int>(m_resolution.y - selectionRectangle.position.y);
 	for (std::size_t y{ 0u }; y < static_cast<std::size_t>(selectionRectangle.size.y); ++y)
 		shiftVectorWrapUp(m_pixels, amount, (selectionRectangle.position.y + y) * m_resolution.x + selectionRectangle.position.x, selectionRectangle.size.x);
-	priv_updatePixels();
+	priv_setDirty(sf::Rect<std::size_t>(selectionRectangle));
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::drawSpan(const sf::Vector2i start, const int length, const std::size_t color)
+{
+	assert(color < m_palette.size());
+	priv_drawSpan(start.y, start.x, start.x + length, static_cast<IndexType>(color));
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::drawLine(const sf::Vector2i start, const sf::Vector2i end, const std::size_t color)
+{
+	assert(color < m_palette.size());
+	const IndexType index{ static_cast<IndexType>(color) };
+	if (start.y == end.y)
+	{
+		priv_drawSpan(start.y, std::min(start.x, end.x), std::max(start.x, end.x) + 1, index);
+		return;
+	}
+
+	// Bresenham
+	const sf::Vector2i delta{ std::abs(end.x - start.x), -std::abs(end.y - start.y) };
+	const sf::Vector2i step{ (start.x < end.x) ? 1 : -1, (start.y < end.y) ? 1 : -1 };
+	int error{ delta.x + delta.y };
+	sf::Vector2i current{ start };
+	while (true)
+	{
+		priv_drawPoint(current, index);
+		if (current == end)
+			break;
+		const int doubleError{ error * 2 };
+		if (doubleError >= delta.y)
+		{
+			error += delta.y;
+			current.x += step.x;
+		}
+		if (doubleError <= delta.x)
+		{
+			error += delta.x;
+			current.y += step.y;
+		}
+	}
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::drawRectangle(const sf::IntRect rectangle, const std::size_t color)
+{
+	assert(color < m_palette.size());
+	if ((rectangle.size.x <= 0) || (rectangle.size.y <= 0))
+		return;
+
+	const IndexType index{ static_cast<IndexType>(color) };
+	const int left{ rectangle.position.x };
+	const int right{ rectangle.position.x + rectangle.size.x };
+	const int top{ rectangle.position.y };
+	const int bottom{ rectangle.position.y + rectangle.size.y - 1 };
+	priv_drawSpan(top, left, right, index);
+	if (bottom != top)
+		priv_drawSpan(bottom, left, right, index);
+	for (int y{ std::max(top + 1, 0) }, end{ std::min(bottom, static_cast<int>(m_resolution.y)) }; y < end; ++y)
+	{
+		priv_drawPoint({ left, y }, index);
+		priv_drawPoint({ right - 1, y }, index);
+	}
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::fillRectangle(const sf::IntRect rectangle, const std::size_t color)
+{
+	assert(color < m_palette.size());
+	const IndexType index{ static_cast<IndexType>(color) };
+	for (int y{ std::max(rectangle.position.y, 0) }, end{ std::min(rectangle.position.y + rectangle.size.y, static_cast<int>(m_resolution.y)) }; y < end; ++y)
+		priv_drawSpan(y, rectangle.position.x, rectangle.position.x + rectangle.size.x, index);
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::drawCircle(const sf::Vector2i center, const int radius, const std::size_t color)
+{
+	assert(color < m_palette.size());
+	if (radius < 0)
+		return;
+
+	// midpoint circle: each step gives a point in each of the eight octants
+	const IndexType index{ static_cast<IndexType>(color) };
+	sf::Vector2i offset{ radius, 0 };
+	int error{ 1 - radius };
+	while (offset.x >= offset.y)
+	{
+		priv_drawPoint({ center.x + offset.x, center.y + offset.y }, index);
+		priv_drawPoint({ center.x - offset.x, center.y + offset.y }, index);
+		priv_drawPoint({ center.x + offset.x, center.y - offset.y }, index);
+		priv_drawPoint({ center.x - offset.x, center.y - offset.y }, index);
+		priv_drawPoint({ center.x + offset.y, center.y + offset.x }, index);
+		priv_drawPoint({ center.x - offset.y, center.y + offset.x }, index);
+		priv_drawPoint({ center.x + offset.y, center.y - offset.x }, index);
+		priv_drawPoint({ center.x - offset.y, center.y - offset.x }, index);
+		++offset.y;
+		if (error < 0)
+			error += offset.y * 2 + 1;
+		else
+		{
+			--offset.x;
+			error += (offset.y - offset.x) * 2 + 1;
+		}
+	}
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::fillCircle(const sf::Vector2i center, const int radius, const std::size_t color)
+{
+	assert(color < m_palette.size());
+	if (radius < 0)
+		return;
+
+	// the same steps as drawCircle with each pair of mirrored points joined by a span
+	const IndexType index{ static_cast<IndexType>(color) };
+	sf::Vector2i offset{ radius, 0 };
+	int error{ 1 - radius };
+	while (offset.x >= offset.y)
+	{
+		priv_drawSpan(center.y + offset.y, center.x - offset.x, center.x + offset.x + 1, index);
+		priv_drawSpan(center.y - offset.y, center.x - offset.x, center.x + offset.x + 1, index);
+		priv_drawSpan(center.y + offset.x, center.x - offset.y, center.x + offset.y + 1, index);
+		priv_drawSpan(center.y - offset.x, center.x - offset.y, center.x + offset.y + 1, index);
+		++offset.y;
+		if (error < 0)
+			error += offset.y * 2 + 1;
+		else
+		{
+			--offset.x;
+			error += (offset.y - offset.x) * 2 + 1;
+		}
+	}
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::floodFill(const sf::Vector2i location, const std::size_t color)
+{
+	assert(color < m_palette.size());
+	if ((location.x < 0) || (location.y < 0) || (location.x >= static_cast<int>(m_resolution.x)) || (location.y >= static_cast<int>(m_resolution.y)))
+		return;
+
+	const IndexType replacement{ static_cast<IndexType>(color) };
+	const IndexType target{ m_pixels[getIndex(sf::Vector2<std::size_t>(location))] };
+	if (target == replacement)
+		return;
+
+	// scanline: fill the whole run containing each seed then add a seed for each run of the target colour directly above and below it
+	std::vector<sf::Vector2<std::size_t>> seeds{ sf::Vector2<std::size_t>(location) };
+	const auto addSeeds = [&](const std::size_t y, const std::size_t left, const std::size_t right)
+	{
+		const auto row{ m_pixels.begin() + y * m_resolution.x };
+		for (std::size_t x{ left }; x < right; ++x)
+		{
+			if ((row[x] == target) && ((x == left) || (row[x - 1u] != target)))
+				seeds.push_back({ x, y });
+		}
+	};
+	while (!seeds.empty())
+	{
+		const sf::Vector2<std::size_t> seed{ seeds.back() };
+		seeds.pop_back();
+		const auto row{ m_pixels.begin() + seed.y * m_resolution.x };
+		if (row[seed.x] != target)
+			continue;
+
+		std::size_t left{ seed.x };
+		while ((left > 0u) && (row[left - 1u] == target))
+			--left;
+		std::size_t right{ seed.x + 1u };
+		while ((right < m_resolution.x) && (row[right] == target))
+			++right;
+		std::fill(row + left, row + right, replacement);
+		priv_setRowDirty(seed.y, left, right);
+
+		if (seed.y > 0u)
+			addSeeds(seed.y - 1u, left, right);
+		if (seed.y + 1u < m_resolution.y)
+			addSeeds(seed.y + 1u, left, right);
+	}
 }
 
-void PixelDisplay::setPalette(const std::vector<sf::Color>& colors)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setPalette(const std::vector<sf::Color>& colors)
 {
+	assert(isPaletteSizeSupported<IndexType>(colors.size()));
 	m_palette = colors;
-	priv_updatePixels();
+	priv_setPaletteChanged();
 }
 
-void PixelDisplay::removeColor(const std::size_t color)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::removeColor(const std::size_t color)
 {
 	assert(color < m_palette.size());
 	m_palette.erase(m_palette.begin() + color);
-	priv_updatePixels();
+	priv_setPaletteChanged();
 }
 
-void PixelDisplay::addRgb(const sf::Color rgb)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::addRgb(const sf::Color rgb)
 {
+	assert(isPaletteSizeSupported<IndexType>(m_palette.size() + 1u));
 	m_palette.emplace_back(rgb);
+	m_isPaletteTextureUpdateRequired = true;
 }
 
-void PixelDisplay::cyclePaletteDown(const std::size_t amount, const std::size_t firstColor, const std::size_t numberOfColors)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::cyclePaletteDown(const std::size_t amount, const std::size_t firstColor, const std::size_t numberOfColors)
 {
 	assert(firstColor < m_palette.size());
 	shiftVectorWrapDown(m_palette, amount, firstColor, numberOfColors);
-	priv_updatePixels();
+	priv_setPaletteChanged();
 }
 
-void PixelDisplay::cyclePaletteUp(const std::size_t amount, const std::size_t firstColor, const std::size_t numberOfColors)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::cyclePaletteUp(const std::size_t amount, const std::size_t firstColor, const std::size_t numberOfColors)
 {
 	assert(firstColor < m_palette.size());
 	shiftVectorWrapUp(m_palette, amount, firstColor, numberOfColors);
-	priv_updatePixels();
+	priv_setPaletteChanged();
 }
 
-std::size_t PixelDisplay::copy()
+template <class IndexType>
+std::size_t BasicPixelDisplay<IndexType>::copy()
 {
 	m_buffers.push_back({ m_resolution.x, m_pixels });
 	return m_buffers.size() - 1u;
 }
 
-void PixelDisplay::copy(const std::size_t index)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::copy(const std::size_t index)
 {
 	assert(index < m_buffers.size());
 	m_buffers[index] = { m_resolution.x, m_pixels };
 }
 
-std::size_t PixelDisplay::copy(const sf::IntRect selectionRectangle)
+template <class IndexType>
+std::size_t BasicPixelDisplay<IndexType>::copy(const sf::IntRect selectionRectangle)
 {
 	m_buffers.emplace_back();
 	priv_copyToBufferFromSelectionRectangle(m_buffers.back(), selectionRectangle);
 	return m_buffers.size() - 1u;
 }
 
-void PixelDisplay::copy(const std::size_t index, const sf::IntRect selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::copy(const std::size_t index, const sf::IntRect selectionRectangle)
 {
 	assert(index < m_buffers.size());
 	priv_copyToBufferFromSelectionRectangle(m_buffers[index], selectionRectangle);
 }
 
-void PixelDisplay::paste(const sf::Vector2i offset)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::paste(const sf::Vector2i offset)
 {
 	assert(m_buffers.size() != 0u);
 	priv_pasteOffsetBuffer(m_buffers.back(), offset);
 }
 
-void PixelDisplay::paste(const std::size_t index, const sf::Vector2i offset)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::paste(const std::size_t index, const sf::Vector2i offset)
 {
 	assert(index < m_buffers.size());
 	priv_pasteOffsetBuffer(m_buffers[index], offset);
 }
 
-void PixelDisplay::removeBuffer()
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::paste(const std::size_t index, const sf::Vector2i offset, const std::size_t transparentColor)
+{
+	assert(index < m_buffers.size());
+	priv_pasteOffsetBuffer(m_buffers[index], offset, true, static_cast<IndexType>(transparentColor));
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::removeBuffer()
 {
 	assert(m_buffers.size() != 0u);
 	m_buffers.pop_back();
 }
 
-void PixelDisplay::removeBuffer(const std::size_t index)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::removeBuffer(const std::size_t index)
 {
 	assert(m_buffers.size() != 0u);
 	m_buffers.erase(m_buffers.begin() + index);
 }
 
-std::size_t PixelDisplay::addBuffer(const sf::Vector2<std::size_t> size)
+template <class IndexType>
+std::size_t BasicPixelDisplay<IndexType>::addBuffer(const sf::Vector2<std::size_t> size)
 {
 	const std::size_t newBufferIndex{ m_buffers.size() };
 	m_buffers.emplace_back();
@@ -442,7 +679,8 @@ std::size_t PixelDisplay::addBuffer(const sf::Vector2<std::size_t> size)
 	return newBufferIndex;
 }
 
-void PixelDisplay::resizeBuffer(const std::size_t index, const sf::Vector2<std::size_t> size)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::resizeBuffer(const std::size_t index, const sf::Vector2<std::size_t> size)
 {
 	assert(index < m_buffers.size());
 	Buffer& buffer{ m_buffers[index] };
@@ -505,13 +743,71 @@ void PixelDisplay::resizeBuffer(const std::size_t index, const sf::Vector2<std::
 	}
 }
 
-sf::Vector2<std::size_t> PixelDisplay::getSizeOfBuffer(const std::size_t index) const
+template <class IndexType>
+sf::Vector2<std::size_t> BasicPixelDisplay<IndexType>::getSizeOfBuffer(const std::size_t index) const
 {
 	assert(index < m_buffers.size());
 	const Buffer& buffer{ m_buffers[index] };
 	return{ buffer.pixels.size() % buffer.width, buffer.pixels.size() / buffer.width };
 }
 
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setRenderMode(const RenderMode renderMode)
+{
+	if (renderMode == m_renderMode)
+		return;
+
+	m_renderMode = renderMode;
+	if (m_renderMode == RenderMode::Texture)
+	{
+		// the per-pixel vertices are replaced by a single quad
+		m_vertices.clear();
+		m_vertices.shrink_to_fit();
+	}
+	else
+	{
+		m_textureColors.clear();
+		m_textureColors.shrink_to_fit();
+		m_texture = sf::Texture{};
+		m_paletteTexture = sf::Texture{};
+	}
+	m_isPaletteTextureUpdateRequired = true;
+	priv_updateVertices();
+	priv_setAllDirty();
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setSmooth(const bool smooth)
+{
+	m_isSmooth = smooth;
+	m_texture.setSmooth(m_isSmooth && !priv_isShaderActive());
+}
+
+template <class IndexType>
+bool BasicPixelDisplay<IndexType>::setUseShader(const bool useShader)
+{
+	const bool wasShaderActive{ priv_isShaderActive() };
+	m_useShader = useShader && sf::Shader::isAvailable();
+	if (m_useShader)
+	{
+		loadPaletteShader();
+		m_useShader = isPaletteShaderLoaded;
+	}
+	if (priv_isShaderActive() != wasShaderActive)
+	{
+		m_texture.setSmooth(m_isSmooth && !m_useShader);
+		m_isPaletteTextureUpdateRequired = true;
+		priv_setAllDirty();
+	}
+	return m_useShader;
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::setUseVertexBuffer(const bool useVertexBuffer, const sf::VertexBuffer::Usage usage)
+{
+	m_vertexBuffer.setEnabled(useVertexBuffer, usage);
+}
+
 
 
 
@@ -521,16 +817,51 @@ sf::Vector2<std::size_t> PixelDisplay::getSizeOfBuffer(const std::size_t index)
 
 // PRIVATE
 
-void PixelDisplay::draw(sf::RenderTarget& target, sf::RenderStates states) const
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	states.texture = nullptr;
+	if (m_renderMode == RenderMode::Texture)
+	{
+		priv_updateTexture();
+		states.texture = &m_texture;
+		if (priv_isShaderActive())
+		{
+			priv_updatePaletteTexture();
+			paletteShader.setUniform("indices", sf::Shader::CurrentTexture);
+			paletteShader.setUniform("palette", m_paletteTexture);
+			paletteShader.setUniform("paletteRows", static_cast<float>(m_paletteTexture.getSize().y));
+			states.shader = &paletteShader;
+		}
+	}
+	else
+	{
+		priv_updateDirtyPixels();
+		states.texture = nullptr;
+	}
 	states.transform *= getTransform();
-	target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+	m_vertexBuffer.draw(target, m_vertices, sf::PrimitiveType::Triangles, states);
 }
 
-void PixelDisplay::priv_updateVertices()
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_updateVertices()
 {
+	if (m_renderMode == RenderMode::Texture)
+	{
+		const sf::Vector2f textureSize{ m_resolution };
+		m_vertices.resize(6u);
+		m_vertices[0u] = { { 0.f, 0.f }, sf::Color::White, { 0.f, 0.f } };
+		m_vertices[1u] = { { 0.f, m_size.y }, sf::Color::White, { 0.f, textureSize.y } };
+		m_vertices[2u] = { { m_size.x, 0.f }, sf::Color::White, { textureSize.x, 0.f } };
+		m_vertices[3u] = { m_size, sf::Color::White, textureSize };
+		m_vertices[4u] = m_vertices[2u];
+		m_vertices[5u] = m_vertices[1u];
+		m_vertexBuffer.invalidate();
+		m_textureColors.resize(m_pixels.size());
+		return;
+	}
+
 	m_vertices.resize(m_resolution.x * m_resolution.y * 6u);
+	m_vertexBuffer.invalidate();
 	for (std::size_t y{ 0u }; y < m_resolution.y; ++y)
 	{
 		for (std::size_t x{ 0u }; x < m_resolution.x; ++x)
@@ -547,31 +878,187 @@ void PixelDisplay::priv_updateVertices()
 	}
 }
 
-void PixelDisplay::priv_updatePixels()
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_setDirty(const sf::Rect<std::size_t>& rectangle)
+{
+	const std::size_t rowEnd{ std::min(rectangle.position.y + rectangle.size.y, m_resolution.y) };
+	const std::size_t columnEnd{ std::min(rectangle.position.x + rectangle.size.x, m_resolution.x) };
+	if ((rectangle.position.y >= rowEnd) || (rectangle.position.x >= columnEnd))
+		return;
+	for (std::size_t y{ rectangle.position.y }; y < rowEnd; ++y)
+		priv_setRowDirty(y, rectangle.position.x, columnEnd);
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_setAllDirty() const
+{
+	m_dirtyRows.assign(m_resolution.y, { 0u, m_resolution.x });
+	m_dirtyRowsBegin = 0u;
+	m_dirtyRowsEnd = m_resolution.y;
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_setIndicesDirty(const std::size_t startIndex, std::size_t numberOfPixels)
+{
+	if ((numberOfPixels == 0u) || ((startIndex + numberOfPixels) > m_pixels.size()))
+		numberOfPixels = m_pixels.size() - startIndex;
+	if ((numberOfPixels == 0u) || (m_resolution.x == 0u))
+		return;
+	const std::size_t firstRow{ startIndex / m_resolution.x };
+	const std::size_t lastRow{ (startIndex + numberOfPixels - 1u) / m_resolution.x };
+	const std::size_t firstColumn{ startIndex % m_resolution.x };
+	const std::size_t lastColumn{ (startIndex + numberOfPixels - 1u) % m_resolution.x };
+	for (std::size_t y{ firstRow }; y <= lastRow; ++y)
+		priv_setRowDirty(y, (y == firstRow) ? firstColumn : 0u, (y == lastRow) ? lastColumn + 1u : m_resolution.x);
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_setRowDirty(const std::size_t row, const std::size_t columnBegin, const std::size_t columnEnd)
+{
+	ColumnSpan& span{ m_dirtyRows[row] };
+	if (span.begin >= span.end)
+		span = { columnBegin, columnEnd };
+	else
+	{
+		span.begin = std::min(span.begin, columnBegin);
+		span.end = std::max(span.end, columnEnd);
+	}
+
+	if (m_dirtyRowsBegin >= m_dirtyRowsEnd)
+	{
+		m_dirtyRowsBegin = row;
+		m_dirtyRowsEnd = row + 1u;
+	}
+	else
+	{
+		m_dirtyRowsBegin = std::min(m_dirtyRowsBegin, row);
+		m_dirtyRowsEnd = std::max(m_dirtyRowsEnd, row + 1u);
+	}
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_updateDirtyPixels() const
+{
+	// changes are only applied here (when drawn) so any number of edits between draws costs a single update of the pixels that they touched
+	if (m_dirtyRowsBegin >= m_dirtyRowsEnd)
+		return;
+
+	const bool isTextureMode{ m_renderMode == RenderMode::Texture };
+	std::size_t firstIndex{ m_pixels.size() };
+	std::size_t endIndex{ 0u };
+	for (std::size_t y{ m_dirtyRowsBegin }; y < m_dirtyRowsEnd; ++y)
+	{
+		ColumnSpan& span{ m_dirtyRows[y] };
+		if (span.begin >= span.end)
+			continue;
+
+		const std::size_t rowBeginIndex{ y * m_resolution.x + span.begin };
+		const std::size_t rowEndIndex{ y * m_resolution.x + span.end };
+		firstIndex = std::min(firstIndex, rowBeginIndex);
+		endIndex = std::max(endIndex, rowEndIndex);
+		span = {};
+		if (isTextureMode)
+		{
+			if (priv_isShaderActive())
+			{
+				for (std::size_t index{ rowBeginIndex }; index < rowEndIndex; ++index)
+					m_textureColors[index] = encodeIndex(m_pixels[index]);
+			}
+			else
+			{
+				for (std::size_t index{ rowBeginIndex }; index < rowEndIndex; ++index)
+					m_textureColors[index] = m_palette[m_pixels[index]];
+			}
+			continue;
+		}
+		for (std::size_t index{ rowBeginIndex }; index < rowEndIndex; ++index)
+		{
+			const sf::Color rgb{ m_palette[m_pixels[index]] };
+			sf::Vertex* const vertices{ m_vertices.data() + index * 6u };
+			vertices[0u].color = rgb;
+			vertices[1u].color = rgb;
+			vertices[2u].color = rgb;
+			vertices[3u].color = rgb;
+			vertices[4u].color = rgb;
+			vertices[5u].color = rgb;
+		}
+	}
+	m_dirtyRowsBegin = 0u;
+	m_dirtyRowsEnd = 0u;
+
+	if (!isTextureMode && (firstIndex < endIndex))
+		m_vertexBuffer.invalidate(firstIndex * 6u, (endIndex - firstIndex) * 6u);
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_updateTexture() const
+{
+	const sf::Vector2u textureSize{ m_resolution };
+	if (m_texture.getSize() != textureSize)
+	{
+		if (!m_texture.resize(textureSize))
+			return;
+		m_texture.setSmooth(m_isSmooth && !priv_isShaderActive());
+		priv_setAllDirty();
+	}
+	if (m_dirtyRowsBegin >= m_dirtyRowsEnd)
+		return;
+
+	// only the band of rows that has changed since the last draw is uploaded
+	const std::size_t rowBegin{ m_dirtyRowsBegin };
+	const std::size_t rowEnd{ m_dirtyRowsEnd };
+	priv_updateDirtyPixels();
+	const std::uint8_t* const firstTexel{ reinterpret_cast<const std::uint8_t*>(m_textureColors.data() + rowBegin * m_resolution.x) };
+	m_texture.update(firstTexel, { textureSize.x, static_cast<unsigned int>(rowEnd - rowBegin) }, { 0u, static_cast<unsigned int>(rowBegin) });
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_updatePaletteTexture() const
 {
-	const std::size_t numberOfPixels{ m_pixels.size() };
-	for (std::size_t i{ 0u }; i < numberOfPixels; ++i)
-		priv_updatePixel(i);
+	// the whole palette is uploaded when any of it changes: its cost depends only on the palette size
+	if (!m_isPaletteTextureUpdateRequired || m_palette.empty())
+		return;
+
+	assert(m_palette.size() <= maximumShaderPaletteSize);
+	const std::size_t numberOfRows{ (m_palette.size() + paletteTextureWidth - 1u) / paletteTextureWidth };
+	const sf::Vector2u textureSize{ static_cast<unsigned int>(paletteTextureWidth), static_cast<unsigned int>(numberOfRows) };
+	if ((m_paletteTexture.getSize() != textureSize) && !m_paletteTexture.resize(textureSize))
+		return;
+
+	const std::size_t numberOfFullRows{ m_palette.size() / paletteTextureWidth };
+	const std::size_t remainder{ m_palette.size() % paletteTextureWidth };
+	const std::uint8_t* const colors{ reinterpret_cast<const std::uint8_t*>(m_palette.data()) };
+	if (numberOfFullRows > 0u)
+		m_paletteTexture.update(colors, { textureSize.x, static_cast<unsigned int>(numberOfFullRows) }, { 0u, 0u });
+	if (remainder > 0u)
+		m_paletteTexture.update(colors + numberOfFullRows * paletteTextureWidth * sizeof(sf::Color), { static_cast<unsigned int>(remainder), 1u }, { 0u, static_cast<unsigned int>(numberOfFullRows) });
+	m_isPaletteTextureUpdateRequired = false;
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_setPaletteChanged()
+{
+	// with the shader, pixels store indices so only the palette needs updating
+	if (priv_isShaderActive())
+		m_isPaletteTextureUpdateRequired = true;
+	else
+		priv_setAllDirty();
 }
 
-void PixelDisplay::priv_updatePixel(const std::size_t index)
+template <class IndexType>
+bool BasicPixelDisplay<IndexType>::priv_isShaderActive() const
 {
-	const std::size_t baseVertexIndex{ index * 6u };
-	const sf::Color rgb{ m_palette[m_pixels[index]] };
-	m_vertices[baseVertexIndex + 0u].color = rgb;
-	m_vertices[baseVertexIndex + 1u].color = rgb;
-	m_vertices[baseVertexIndex + 2u].color = rgb;
-	m_vertices[baseVertexIndex + 3u].color = rgb;
-	m_vertices[baseVertexIndex + 4u].color = rgb;
-	m_vertices[baseVertexIndex + 5u].color = rgb;
+	return m_useShader && (m_renderMode == RenderMode::Texture);
 }
 
-std::size_t PixelDisplay::priv_getRandomColor() const
+template <class IndexType>
+std::size_t BasicPixelDisplay<IndexType>::priv_getRandomColor() const
 {
-	return std::uniform_int_distribution<std::size_t>(0u, m_palette.size() - 1u)(randomGenerator);
+	return m_random.getInteger(static_cast<std::uint32_t>(m_palette.size() - 1u));
 }
 
-void PixelDisplay::priv_copyToBufferFromSelectionRectangle(Buffer& buffer, const sf::IntRect& selectionRectangle)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_copyToBufferFromSelectionRectangle(Buffer& buffer, const sf::IntRect& selectionRectangle)
 {
 	assert(priv_isSelectionRectangleFullyContained(selectionRectangle));
 	buffer.width = selectionRectangle.size.x;
@@ -579,25 +1066,68 @@ void PixelDisplay::priv_copyToBufferFromSelectionRectangle(Buffer& buffer, const
 	sf::Rect<std::size_t> rectangle(selectionRectangle);
 	for (std::size_t y{ 0u }; y < rectangle.size.y; ++y)
 	{
-		for (std::size_t x{ 0u }; x < buffer.width; ++x)
-			buffer.pixels[y * buffer.width + x] = m_pixels[(y + rectangle.position.y) * buffer.width + (x + rectangle.position.x)];
+		const auto row{ m_pixels.begin() + (y + rectangle.position.y) * m_resolution.x + rectangle.position.x };
+		std::copy(row, row + buffer.width, buffer.pixels.begin() + y * buffer.width);
 	}
 }
 
-void PixelDisplay::priv_pasteOffsetBuffer(const Buffer& buffer, const sf::Vector2i& offset)
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_pasteOffsetBuffer(const Buffer& buffer, const sf::Vector2i& offset, const bool isMasked, const IndexType transparentColor)
 {
-	//const unsigned int bufferHeight{ buffer.pixels.size() / buffer.width };
-	for (std::size_t i{ 0u }; i < buffer.pixels.size(); ++i)
+	if (buffer.width == 0u)
+		return;
+
+	// clip the buffer to the display so that each row is pasted as a single copy
+	const int bufferWidth{ static_cast<int>(buffer.width) };
+	const int bufferHeight{ static_cast<int>(buffer.pixels.size() / buffer.width) };
+	const int firstX{ std::max(0, -offset.x) };
+	const int endX{ std::min(bufferWidth, static_cast<int>(m_resolution.x) - offset.x) };
+	const int firstY{ std::max(0, -offset.y) };
+	const int endY{ std::min(bufferHeight, static_cast<int>(m_resolution.y) - offset.y) };
+	if ((firstX < endX) && (firstY < endY))
 	{
-		const sf::Vector2i destination{ static_cast<int>(i % buffer.width) + offset.x, static_cast<int>(i / buffer.width) + offset.y };
-		if (destination.x < 0 || destination.y < 0 || destination.x >= static_cast<int>(m_resolution.x) || destination.y >= static_cast<int>(m_resolution.y))
-			continue;
-		m_pixels[static_cast<std::size_t>(destination.y * m_resolution.x + destination.x)] = buffer.pixels[i];
+		for (int y{ firstY }; y < endY; ++y)
+		{
+			const auto bufferRow{ buffer.pixels.begin() + y * bufferWidth };
+			const std::size_t displayIndex{ static_cast<std::size_t>((y + offset.y) * static_cast<int>(m_resolution.x) + offset.x + firstX) }; // first pasted pixel of the row. an index so that no iterator is formed before the start of the pixels
+			if (isMasked)
+			{
+				for (int x{ firstX }; x < endX; ++x)
+				{
+					if (bufferRow[x] != transparentColor)
+						m_pixels[displayIndex + static_cast<std::size_t>(x - firstX)] = bufferRow[x];
+				}
+			}
+			else
+				std::copy(bufferRow + firstX, bufferRow + endX, m_pixels.begin() + displayIndex);
+		}
+		priv_setDirty({ { static_cast<std::size_t>(offset.x + firstX), static_cast<std::size_t>(offset.y + firstY) }, { static_cast<std::size_t>(endX - firstX), static_cast<std::size_t>(endY - firstY) } });
 	}
-	priv_updatePixels();
 }
 
-bool PixelDisplay::priv_isSelectionRectangleFullyContained(const sf::IntRect& selectionRectangle) const
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_drawSpan(const int y, int left, int right, const IndexType color)
+{
+	if ((y < 0) || (y >= static_cast<int>(m_resolution.y)))
+		return;
+	left = std::max(left, 0);
+	right = std::min(right, static_cast<int>(m_resolution.x));
+	if (left >= right)
+		return;
+
+	const auto row{ m_pixels.begin() + static_cast<std::size_t>(y) * m_resolution.x };
+	std::fill(row + left, row + right, color);
+	priv_setRowDirty(static_cast<std::size_t>(y), static_cast<std::size_t>(left), static_cast<std::size_t>(right));
+}
+
+template <class IndexType>
+void BasicPixelDisplay<IndexType>::priv_drawPoint(const sf::Vector2i location, const IndexType color)
+{
+	priv_drawSpan(location.y, location.x, location.x + 1, color);
+}
+
+template <class IndexType>
+bool BasicPixelDisplay<IndexType>::priv_isSelectionRectangleFullyContained(const sf::IntRect& selectionRectangle) const
 {
 	return (selectionRectangle.position.x >= 0 &&
 		selectionRectangle.position.y >= 0 &&
@@ -607,4 +1137,8 @@ bool PixelDisplay::priv_isSelectionRectangleFullyContained(const sf::IntRect& se
 		static_cast<std::size_t>(selectionRectangle.position.y + selectionRectangle.size.y) <= m_resolution.y);
 }
 
+template class BasicPixelDisplay<std::uint8_t>;
+template class BasicPixelDisplay<std::uint16_t>;
+template class BasicPixelDisplay<std::uint32_t>;
+
 } // namespace selbaward
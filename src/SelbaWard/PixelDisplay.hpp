@@ -34,15 +34,32 @@
 #define SELBAWARD_PIXELDISPLAY_HPP
 
 #include "Common.hpp"
+#include "VertexBufferCache.hpp"
+#include "Random.hpp"
+
+#include <SFML/Graphics/Texture.hpp>
+
+#include <cstdint>
+#include <type_traits>
 
 namespace selbaward
 {
 
 // SW PixelDisplay v1.0.3
-class PixelDisplay : public sf::Drawable, public sf::Transformable
+// IndexType stores each pixel's palette index; it limits the size of the palette (e.g. 256 colours for std::uint8_t). std::uint8_t, std::uint16_t and std::uint32_t are available (see aliases below)
+template <class IndexType>
+class BasicPixelDisplay : public sf::Drawable, public sf::Transformable
 {
+	static_assert(std::is_integral_v<IndexType> && std::is_unsigned_v<IndexType>, "PixelDisplay index type must be an unsigned integer");
+
 public:
-	PixelDisplay();
+	enum class RenderMode
+	{
+		Vertices, // a coloured quad per pixel
+		Texture, // palette colours are expanded into a texture (one RGBA texel per pixel) that is drawn as a single quad
+	};
+
+	BasicPixelDisplay();
 
 	std::size_t getIndex(sf::Vector2<std::size_t> location) const { return m_resolution.x * location.y + location.x; }
 
@@ -62,6 +79,7 @@ public:
 	void fill(std::size_t color);
 	void clear();
 	void randomize();
+	void setSeed(std::uint64_t seed) { m_random.setSeed(seed); } // seeds this display's random number generator (used by randomize) for reproducible results
 
 	// manual shifting/scrolling
 	void shiftLeft(std::size_t amount = 1u, std::size_t startIndex = 0u, std::size_t numberOfPixels = 0u);
@@ -75,6 +93,15 @@ public:
 	void scrollWrapLeft(std::size_t amount = 1u, sf::IntRect selectionRectangle = { { 0, 0 }, { 0, 0 } });
 	void scrollWrapRight(std::size_t amount = 1u, sf::IntRect selectionRectangle = { { 0, 0 }, { 0, 0 } });
 
+	// drawing (clipped to the display)
+	void drawSpan(sf::Vector2i start, int length, std::size_t color); // horizontal run of pixels starting at start
+	void drawLine(sf::Vector2i start, sf::Vector2i end, std::size_t color); // includes both ends
+	void drawRectangle(sf::IntRect rectangle, std::size_t color); // outline
+	void fillRectangle(sf::IntRect rectangle, std::size_t color);
+	void drawCircle(sf::Vector2i center, int radius, std::size_t color); // outline
+	void fillCircle(sf::Vector2i center, int radius, std::size_t color);
+	void floodFill(sf::Vector2i location, std::size_t color); // replaces the connected (4-way) area of the colour at location
+
 	// palette
 	void setPalette(const std::vector<sf::Color>& palette);
 	void setPaletteSize(std::size_t numberOfColors);
@@ -94,6 +121,7 @@ public:
 	void copy(std::size_t index); // copies over (replaces) an existing buffer
 	void copy(std::size_t index, sf::IntRect selectionRectangle);
 	void paste(std::size_t index, sf::Vector2i offset = { 0, 0 }); // replace with saved buffer
+	void paste(std::size_t index, sf::Vector2i offset, std::size_t transparentColor); // replace with saved buffer, leaving pixels where the buffer has the transparent colour
 	void removeBuffer(std::size_t index); // as usual, when one buffer is removed, the indices of all following buffers are decreased
 	void removeAllBuffers() { m_buffers.clear(); }
 	std::size_t addBuffer(sf::Vector2<std::size_t> size = { 1u, 1u }); // returns index of new buffer
@@ -101,48 +129,95 @@ public:
 	std::size_t getNumberOfBuffers() const { return m_buffers.size(); }
 	sf::Vector2<std::size_t> getSizeOfBuffer(std::size_t index) const;
 
+	// render mode
+	void setRenderMode(RenderMode renderMode);
+	RenderMode getRenderMode() const { return m_renderMode; }
+	void setSmooth(bool smooth); // texture mode only: linear filtering instead of nearest (crisp) pixels
+	bool getSmooth() const { return m_isSmooth; }
+	bool setUseShader(bool useShader); // texture mode only: the texture holds palette indices that a shader looks up in a palette texture so palette changes (e.g. cycling) only upload the palette. palettes of up to 65536 colours. smooth is ignored. returns whether the shader is used (shaders must be available)
+	bool getUseShader() const { return m_useShader; }
+
+	// vertex buffer
+	void setUseVertexBuffer(bool useVertexBuffer, sf::VertexBuffer::Usage usage = sf::VertexBuffer::Usage::Static); // keeps the vertices on the GPU, uploading only those that change (vertices are drawn directly if vertex buffers are unavailable)
+	bool getUseVertexBuffer() const { return m_vertexBuffer.getEnabled(); }
+
 
 private:
 	sf::Vector2<std::size_t> m_resolution;
 	sf::Vector2f m_size;
 	std::vector<sf::Color> m_palette;
-	std::vector<std::size_t> m_pixels;
-	std::vector<sf::Vertex> m_vertices;
+	std::vector<IndexType> m_pixels;
+	mutable std::vector<sf::Vertex> m_vertices;
+	mutable VertexBufferCache m_vertexBuffer;
+	RenderMode m_renderMode;
+	bool m_isSmooth;
+	mutable std::vector<sf::Color> m_textureColors; // texture mode: palette-expanded pixels (RGBA), uploaded to the texture when drawn. with the shader, each holds an encoded palette index instead
+	mutable sf::Texture m_texture;
+	bool m_useShader;
+	mutable sf::Texture m_paletteTexture; // shader only: the palette, 256 colours per row
+	mutable bool m_isPaletteTextureUpdateRequired;
+
+	// pixels changed since the last draw (applied to the vertices/texture when drawn)
+	struct ColumnSpan
+	{
+		std::size_t begin{};
+		std::size_t end{};
+	};
+	mutable std::vector<ColumnSpan> m_dirtyRows; // one per row
+	mutable std::size_t m_dirtyRowsBegin;
+	mutable std::size_t m_dirtyRowsEnd;
+
+	mutable Random m_random;
 
 	// buffers
 	struct Buffer
 	{
 		std::size_t width{};
-		std::vector<std::size_t> pixels{};
+		std::vector<IndexType> pixels{};
 	};
 	std::vector<Buffer> m_buffers;
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 	void priv_updateVertices();
-	void priv_updatePixels();
-	void priv_updatePixel(const std::size_t index);
+	void priv_setDirty(const sf::Rect<std::size_t>& rectangle);
+	void priv_setAllDirty() const;
+	void priv_setIndicesDirty(std::size_t startIndex, std::size_t numberOfPixels);
+	void priv_setRowDirty(std::size_t row, std::size_t columnBegin, std::size_t columnEnd);
+	void priv_updateDirtyPixels() const;
+	void priv_updateTexture() const;
+	void priv_updatePaletteTexture() const;
+	void priv_setPaletteChanged();
+	bool priv_isShaderActive() const;
 	std::size_t priv_getRandomColor() const;
 	void priv_copyToBufferFromSelectionRectangle(Buffer& buffer, const sf::IntRect& selectionRectangle);
-	void priv_pasteOffsetBuffer(const Buffer& buffer, const sf::Vector2i& offset);
+	void priv_pasteOffsetBuffer(const Buffer& buffer, const sf::Vector2i& offset, bool isMasked = false, IndexType transparentColor = 0u);
+	void priv_drawSpan(int y, int left, int right, IndexType color);
+	void priv_drawPoint(sf::Vector2i location, IndexType color);
 	bool priv_isSelectionRectangleFullyContained(const sf::IntRect& selectionRectangle) const;
 };
 
+using PixelDisplay = BasicPixelDisplay<std::uint32_t>;
+using PixelDisplay8 = BasicPixelDisplay<std::uint8_t>; // palettes of up to 256 colours
+using PixelDisplay16 = BasicPixelDisplay<std::uint16_t>; // palettes of up to 65536 colours
+
 
 
 
 
 
 
+template <class IndexType>
 template <class T>
-void PixelDisplay::setPixels(const T* colors, const std::size_t numberOfColors, const std::size_t startIndex)
+void BasicPixelDisplay<IndexType>::setPixels(const T* colors, const std::size_t numberOfColors, const std::size_t startIndex)
 {
 	for (std::size_t i{ 0u }; i < numberOfColors; ++i)
-		m_pixels[startIndex + i] = static_cast<std::size_t>(colors[i]);
-	priv_updatePixels();
+		m_pixels[startIndex + i] = static_cast<IndexType>(colors[i]);
+	priv_setIndicesDirty(startIndex, numberOfColors);
 }
 
+template <class IndexType>
 template <class T>
-void PixelDisplay::getPixels(T* colors, const std::size_t numberOfColors, const std::size_t startIndex) const
+void BasicPixelDisplay<IndexType>::getPixels(T* colors, const std::size_t numberOfColors, const std::size_t startIndex) const
 {
 	for (std::size_t i{ 0u }; i < numberOfColors; ++i)
 		colors[i] = static_cast<T>(m_pixels[startIndex + i]);
@@ -104,6 +104,7 @@ Polygon::Polygon()
 	, m_vertices{}
 	, m_triangles{}
 	, m_outputVertices{}
+	, m_vertexBuffer{}
 	, m_holeStartIndices{}
 	, m_color{ sf::Color::White }
 	, m_showWireframe{ false }
@@ -131,6 +132,7 @@ Polygon::Polygon(const Polygon& other)
 	, m_vertices{ other.m_vertices }
 	, m_triangles{ other.m_triangles }
 	, m_outputVertices{ other.m_outputVertices }
+	, m_vertexBuffer{ other.m_vertexBuffer }
 	, m_holeStartIndices{ other.m_holeStartIndices }
 	, m_color{ other.m_color }
 	, m_showWireframe{ other.m_showWireframe }
@@ -149,6 +151,7 @@ Polygon& Polygon::operator=(const Polygon& other)
 	m_vertices = other.m_vertices;
 	m_triangles = other.m_triangles;
 	m_outputVertices = other.m_outputVertices;
+	m_vertexBuffer = other.m_vertexBuffer;
 	m_holeStartIndices = other.m_holeStartIndices;
 	m_color = other.m_color;
 	m_showWireframe = other.m_showWireframe;
@@ -314,6 +317,16 @@ sf::Color Polygon::getWireframeColor() const
 	return m_wireframeColor;
 }
 
+void Polygon::setUseVertexBuffer(const bool useVertexBuffer, const sf::VertexBuffer::Usage usage)
+{
+	m_vertexBuffer.setEnabled(useVertexBuffer, usage);
+}
+
+bool Polygon::getUseVertexBuffer() const
+{
+	return m_vertexBuffer.getEnabled();
+}
+
 float Polygon::getPerimeter() const
 {
 	const std::size_t numberOfVertices{ m_vertices.size() };
@@ -530,7 +543,7 @@ void Polygon::draw(sf::RenderTarget& target, sf::RenderStates states) const
 	states.texture = m_texture;
 	states.transform *= getTransform();
 	if (!m_outputVertices.empty())
-		target.draw(m_outputVertices.data(), m_outputVertices.size(), sf::PrimitiveType::Triangles, states);
+		m_vertexBuffer.draw(target, m_outputVertices, sf::PrimitiveType::Triangles, states);
 	if (m_showWireframe && !m_wireframeVertices.empty())
 	{
 		states.texture = nullptr;
@@ -546,6 +559,7 @@ void Polygon::priv_update()
 
 void Polygon::priv_updateOutputVertices()
 {
+	m_vertexBuffer.invalidate();
 	m_outputVertices.resize(m_triangles.size() * 3u);
 	for (std::size_t t{ 0u }; t < m_triangles.size(); ++t)
 	{
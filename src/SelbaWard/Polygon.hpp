@@ -34,6 +34,7 @@
 #define SELBAWARD_POLYGON_HPP
 
 #include "Common.hpp"
+#include "VertexBufferCache.hpp"
 #include <array>
 
 namespace selbaward
@@ -99,6 +100,9 @@ public:
 	void setWireframeColor(sf::Color wireframeColor);
 	sf::Color getWireframeColor() const;
 
+	void setUseVertexBuffer(bool useVertexBuffer, sf::VertexBuffer::Usage usage = sf::VertexBuffer::Usage::Static); // keeps the output vertices on the GPU, re-uploading them only after an update (vertices are drawn directly if vertex buffers are unavailable). the wireframe is always drawn directly
+	bool getUseVertexBuffer() const;
+
 	float getPerimeter() const;
 	float getArea() const;
 
@@ -142,6 +146,7 @@ private:
 	std::vector<sf::Vertex> m_vertices;
 	std::vector<TriangleIndices> m_triangles;
 	std::vector<sf::Vertex> m_outputVertices;
+	mutable VertexBufferCache m_vertexBuffer;
 	std::vector<std::size_t> m_holeStartIndices;
 	sf::Color m_color;
 
@@ -32,6 +32,8 @@
 
 #include "ProgressBar.hpp"
 
+#include <array>
+
 namespace selbaward
 {
 
@@ -192,21 +194,63 @@ sf::Vector2f ProgressBar::getAnchorProgressBottom() const
 	return getTransform().transformPoint({ m_size.x * m_amount, m_size.y });
 }
 
-
-
-// PRIVATE
-void ProgressBar::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void ProgressBar::appendVertices(VertexSink& sink, sf::RenderStates states) const
 {
 	states.transform *= getTransform();
 	if (m_showBackground)
-		target.draw(m_backgroundAndFrame, states);
+	{
+		// background and frame are submitted as the rectangle shape would draw them: textured fill followed by untextured outline
+		const sf::FloatRect textureRect{ m_backgroundTextureRectangle };
+		const sf::Color backgroundColor{ m_backgroundAndFrame.getFillColor() };
+		const std::array<sf::Vertex, 4u> background
+		{ {
+			{ { 0.f, 0.f }, backgroundColor, textureRect.position },
+			{ { 0.f, m_size.y }, backgroundColor, { textureRect.position.x, textureRect.position.y + textureRect.size.y } },
+			{ { m_size.x, 0.f }, backgroundColor, { textureRect.position.x + textureRect.size.x, textureRect.position.y } },
+			{ m_size, backgroundColor, textureRect.position + textureRect.size }
+		} };
+		states.texture = m_backgroundTexture;
+		sink.append(background.data(), background.size(), sf::PrimitiveType::TriangleStrip, states);
+
+		const float frameThickness{ m_backgroundAndFrame.getOutlineThickness() };
+		if (frameThickness != 0.f)
+		{
+			const sf::Color frameColor{ m_backgroundAndFrame.getOutlineColor() };
+			const std::array<sf::Vector2f, 4u> corners{ sf::Vector2f{ 0.f, 0.f }, sf::Vector2f{ m_size.x, 0.f }, m_size, sf::Vector2f{ 0.f, m_size.y } };
+			const std::array<sf::Vector2f, 4u> directions{ sf::Vector2f{ -1.f, -1.f }, sf::Vector2f{ 1.f, -1.f }, sf::Vector2f{ 1.f, 1.f }, sf::Vector2f{ -1.f, 1.f } };
+			std::array<sf::Vertex, 10u> frame;
+			for (std::size_t i{ 0u }; i < frame.size(); i += 2u)
+			{
+				const std::size_t corner{ (i / 2u) % 4u };
+				frame[i] = { corners[corner], frameColor };
+				frame[i + 1u] = { corners[corner] + directions[corner] * frameThickness, frameColor };
+			}
+			states.texture = nullptr;
+			sink.append(frame.data(), frame.size(), sf::PrimitiveType::TriangleStrip, states);
+		}
+	}
 	if (m_showBar)
 	{
 		states.texture = m_texture;
-		target.draw(m_bar.data(), 4u, sf::PrimitiveType::TriangleStrip, states);
+		sink.append(m_bar.data(), 4u, sf::PrimitiveType::TriangleStrip, states);
 	}
 }
 
+void ProgressBar::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
+{
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
+
+
+
+// PRIVATE
+void ProgressBar::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	RenderTargetVertexSink sink{ target };
+	appendVertices(sink, states);
+}
+
 void ProgressBar::priv_updateGraphics()
 {
 	m_backgroundAndFrame.setSize(m_size);
@@ -34,6 +34,7 @@
 #define SELBAWARD_PROGRESSBAR_HPP
 
 #include "Common.hpp"
+#include "VertexSink.hpp"
 
 #include <SFML/Graphics/RectangleShape.hpp> // simple box drawing (for background and outline)
 #include <SFML/Graphics/Texture.hpp>
@@ -93,6 +94,10 @@ public:
 	sf::Vector2f getAnchorProgressCenter() const;
 	sf::Vector2f getAnchorProgressBottom() const;
 
+	// vertex sink
+	void appendVertices(VertexSink& sink, sf::RenderStates states = sf::RenderStates::Default) const; // submits what would be drawn to a sink instead of a render target
+	void appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform = sf::Transform::Identity) const; // appends what would be drawn as transformed triangles
+
 private:
 	float m_amount;
 	bool m_showBar;
@@ -0,0 +1,79 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Selba Ward (https://github.com/Hapaxia/SelbaWard)
+// --
+//
+// Random
+//
+// Copyright(c) 2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Random.hpp"
+
+#include <random>
+
+namespace
+{
+
+std::uint64_t splitMix64(std::uint64_t& state)
+{
+	std::uint64_t result{ (state += 0x9E3779B97F4A7C15u) };
+	result = (result ^ (result >> 30u)) * 0xBF58476D1CE4E5B9u;
+	result = (result ^ (result >> 27u)) * 0x94D049BB133111EBu;
+	return result ^ (result >> 31u);
+}
+
+} // namespace
+
+namespace selbaward
+{
+
+Random::Random()
+	: m_state{}
+{
+	setSeed();
+}
+
+Random::Random(const std::uint64_t seed)
+	: m_state{}
+{
+	setSeed(seed);
+}
+
+void Random::setSeed(std::uint64_t seed)
+{
+	// the seed is expanded so that similar seeds (and zero) still produce well-mixed, non-zero states
+	const std::uint64_t a{ splitMix64(seed) };
+	const std::uint64_t b{ splitMix64(seed) };
+	m_state = { static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(a >> 32u), static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(b >> 32u) };
+}
+
+void Random::setSeed()
+{
+	std::random_device randomDevice;
+	setSeed((static_cast<std::uint64_t>(randomDevice()) << 32u) ^ randomDevice());
+}
+
+} // namespace selbaward
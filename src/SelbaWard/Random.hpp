@@ -0,0 +1,93 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Selba Ward (https://github.com/Hapaxia/SelbaWard)
+// --
+//
+// Random
+//
+// Copyright(c) 2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef SELBAWARD_RANDOM_HPP
+#define SELBAWARD_RANDOM_HPP
+
+#include "Common.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace selbaward
+{
+
+// SW Random v1.0.0
+// small and fast pseudo-random number generator (xoshiro128**) for objects to own individually.
+// a seed produces the same sequence on every platform. satisfies UniformRandomBitGenerator so can also be used with standard distributions
+class Random
+{
+public:
+	using result_type = std::uint32_t;
+
+	Random(); // seeded non-deterministically
+	explicit Random(std::uint64_t seed);
+	void setSeed(std::uint64_t seed);
+	void setSeed(); // non-deterministic seed
+	result_type operator()();
+	std::uint32_t getInteger(std::uint32_t maximum); // from 0 to maximum (inclusive)
+	float getFloat(float low, float high); // from low (inclusive) to high (exclusive)
+	static constexpr result_type min() { return 0u; }
+	static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+private:
+	std::array<std::uint32_t, 4u> m_state;
+};
+
+inline Random::result_type Random::operator()()
+{
+	const auto rotateLeft = [](const std::uint32_t value, const int amount) { return (value << amount) | (value >> (32 - amount)); };
+	const std::uint32_t result{ rotateLeft(m_state[1u] * 5u, 7) * 9u };
+	const std::uint32_t t{ m_state[1u] << 9u };
+	m_state[2u] ^= m_state[0u];
+	m_state[3u] ^= m_state[1u];
+	m_state[1u] ^= m_state[2u];
+	m_state[0u] ^= m_state[3u];
+	m_state[2u] ^= t;
+	m_state[3u] = rotateLeft(m_state[3u], 11);
+	return result;
+}
+
+inline std::uint32_t Random::getInteger(const std::uint32_t maximum)
+{
+	// multiply-shift maps the full 32-bit range onto the requested range without division
+	return static_cast<std::uint32_t>((static_cast<std::uint64_t>((*this)()) * (static_cast<std::uint64_t>(maximum) + 1u)) >> 32u);
+}
+
+inline float Random::getFloat(const float low, const float high)
+{
+	constexpr float unitScale{ 1.f / 16777216.f }; // 2^-24 (the 24 bits that a float can represent exactly)
+	return low + (high - low) * static_cast<float>((*this)() >> 8u) * unitScale;
+}
+
+} // namespace selbaward
+#endif // SELBAWARD_RANDOM_HPP
@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Selba Ward (https://github.com/Hapaxia/SelbaWard)
+// --
+//
+// Render Batcher
+//
+// Copyright(c) 2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "RenderBatcher.hpp"
+
+namespace selbaward
+{
+
+RenderBatcher::RenderBatcher()
+	: m_vertices()
+	, m_batches()
+	, m_numberOfSubmissions{ 0u }
+{
+}
+
+void RenderBatcher::clear()
+{
+	m_vertices.clear();
+	m_batches.clear();
+	m_numberOfSubmissions = 0u;
+}
+
+void RenderBatcher::reserve(const std::size_t numberOfVertices, const std::size_t numberOfBatches)
+{
+	m_vertices.reserve(numberOfVertices);
+	m_batches.reserve(numberOfBatches);
+}
+
+void RenderBatcher::append(const sf::Vertex* const vertices, const std::size_t numberOfVertices, const sf::PrimitiveType primitiveType, const sf::RenderStates& states)
+{
+	++m_numberOfSubmissions;
+
+	const std::size_t firstVertex{ m_vertices.size() };
+	TriangleVertexSink::appendTriangles(m_vertices, vertices, numberOfVertices, primitiveType, states.transform);
+	const std::size_t numberOfAppendedVertices{ m_vertices.size() - firstVertex };
+	if (numberOfAppendedVertices == 0u)
+		return;
+
+	// only the most recent batch can be extended; merging with any earlier batch would change the order in which things are drawn
+	if (!m_batches.empty() && priv_canMerge(m_batches.back(), states))
+		m_batches.back().numberOfVertices += numberOfAppendedVertices;
+	else
+		m_batches.push_back({ states.texture, states.shader, states.blendMode, states.coordinateType, firstVertex, numberOfAppendedVertices });
+}
+
+
+
+// PRIVATE
+
+void RenderBatcher::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	// vertices are already transformed by their own transforms so only the transform passed to draw is used
+	for (const auto& batch : m_batches)
+	{
+		states.texture = batch.texture;
+		states.shader = batch.shader;
+		states.blendMode = batch.blendMode;
+		states.coordinateType = batch.coordinateType;
+		target.draw(m_vertices.data() + batch.firstVertex, batch.numberOfVertices, sf::PrimitiveType::Triangles, states);
+	}
+}
+
+bool RenderBatcher::priv_canMerge(const Batch& batch, const sf::RenderStates& states) const
+{
+	return (batch.texture == states.texture) && (batch.shader == states.shader) && (batch.blendMode == states.blendMode) && (batch.coordinateType == states.coordinateType);
+}
+
+} // namespace selbaward
@@ -0,0 +1,106 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Selba Ward (https://github.com/Hapaxia/SelbaWard)
+// --
+//
+// Render Batcher
+//
+// Copyright(c) 2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef SELBAWARD_RENDERBATCHER_HPP
+#define SELBAWARD_RENDERBATCHER_HPP
+
+#include "Common.hpp"
+#include "VertexSink.hpp"
+
+namespace selbaward
+{
+
+// SW Render Batcher v1.0.0
+// collects drawables for a frame (any drawable with appendVertices) and draws them in order, merging consecutive submissions that share the same render states (other than transform)
+class RenderBatcher : public sf::Drawable, public VertexSink
+{
+public:
+	RenderBatcher();
+	void clear(); // starts a new frame (keeps allocated memory)
+	void reserve(std::size_t numberOfVertices, std::size_t numberOfBatches = 0u);
+	template <class T>
+	void add(const T& drawable, sf::RenderStates states = sf::RenderStates::Default);
+	void append(const sf::Vertex* vertices, std::size_t numberOfVertices, sf::PrimitiveType primitiveType, const sf::RenderStates& states) override;
+
+	// statistics (for the current frame)
+	std::size_t getNumberOfSubmissions() const; // appends received (the number of draw calls if each were drawn directly)
+	std::size_t getNumberOfBatches() const; // draw calls needed to draw the frame
+	std::size_t getNumberOfVertices() const;
+	std::size_t getNumberOfStateBreaks() const; // times consecutive submissions could not be merged due to differing states
+
+private:
+	struct Batch
+	{
+		const sf::Texture* texture;
+		const sf::Shader* shader;
+		sf::BlendMode blendMode;
+		sf::CoordinateType coordinateType;
+		std::size_t firstVertex;
+		std::size_t numberOfVertices;
+	};
+
+	std::vector<sf::Vertex> m_vertices;
+	std::vector<Batch> m_batches;
+	std::size_t m_numberOfSubmissions;
+
+	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+	bool priv_canMerge(const Batch& batch, const sf::RenderStates& states) const;
+};
+
+template <class T>
+inline void RenderBatcher::add(const T& drawable, const sf::RenderStates states)
+{
+	drawable.appendVertices(*this, states);
+}
+
+inline std::size_t RenderBatcher::getNumberOfSubmissions() const
+{
+	return m_numberOfSubmissions;
+}
+
+inline std::size_t RenderBatcher::getNumberOfBatches() const
+{
+	return m_batches.size();
+}
+
+inline std::size_t RenderBatcher::getNumberOfVertices() const
+{
+	return m_vertices.size();
+}
+
+inline std::size_t RenderBatcher::getNumberOfStateBreaks() const
+{
+	return m_batches.empty() ? 0u : m_batches.size() - 1u;
+}
+
+} // namespace selbaward
+#endif // SELBAWARD_RENDERBATCHER_HPP
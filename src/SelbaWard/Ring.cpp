@@ -196,17 +196,29 @@ float Ring::getSectorOffset() const
 	return m_sectorOffset;
 }
 
+void Ring::appendVertices(VertexSink& sink, sf::RenderStates states) const
+{
+	states.texture = m_texture;
+	states.transform *= getTransform();
+
+	if (!m_vertices.empty())
+		sink.append(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::TriangleStrip, states);
+}
+
+void Ring::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
+{
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
+
 
 
 // PRIVATE
 
 void Ring::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	states.texture = m_texture;
-	states.transform *= getTransform();
-
-	if (!m_vertices.empty())
-		target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::TriangleStrip, states);
+	RenderTargetVertexSink sink{ target };
+	appendVertices(sink, states);
 }
 
 void Ring::priv_updateVertices()
@@ -34,6 +34,7 @@
 #define SELBAWARD_RING_HPP
 
 #include "Common.hpp"
+#include "VertexSink.hpp"
 
 namespace selbaward
 {
@@ -62,6 +63,10 @@ public:
 	void setSectorOffset(float sectorOffset);
 	float getSectorOffset() const;
 
+	// vertex sink
+	void appendVertices(VertexSink& sink, sf::RenderStates states = sf::RenderStates::Default) const; // submits what would be drawn to a sink instead of a render target
+	void appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform = sf::Transform::Identity) const; // appends what would be drawn as transformed triangles
+
 private:
 	float m_radius;
 	float m_hole;
@@ -34,7 +34,6 @@
 
 #include <cmath>
 #include <assert.h>
-#include <random>
 #include <algorithm>
 #include <initializer_list>
 
@@ -49,20 +48,6 @@ constexpr float radiansFromDegreesMultipler{ pi / 180.f };
 constexpr float degreesFromRadiansMultiplier{ 1.f / radiansFromDegreesMultipler };
 constexpr sf::PrimitiveType thickPrimitiveType{ sf::PrimitiveType::TriangleStrip };
 
-std::mt19937 randomGenerator;
-
-inline void randomSeed()
-{
-	std::random_device rd;
-	randomGenerator.seed(rd());
-}
-
-inline float randomValue(const float range)
-{
-	assert(range > 0.f);
-	return std::uniform_real_distribution<float>{ 0.f, range }(randomGenerator);
-}
-
 inline bool isSecondVectorClockwiseOfFirstVector(const sf::Vector2f& first, const sf::Vector2f& second)
 {
 	return first.x * second.y > first.y * second.x;
@@ -176,6 +161,7 @@ Spline::Spline(const std::size_t vertexCount, const sf::Vector2f initialPosition
 	, m_interpolatedVertices{}
 	, m_interpolatedVerticesUnitTangents{}
 	, m_outputVertices{}
+	, m_vertexBuffer{}
 	, m_primitiveType{ sf::PrimitiveType::LineStrip }
 	, m_interpolationSteps{ 0u }
 	, m_useBezier{ false }
@@ -183,8 +169,8 @@ Spline::Spline(const std::size_t vertexCount, const sf::Vector2f initialPosition
 	, m_showHandles{ false }
 	, m_lockHandleMirror{ true }
 	, m_lockHandleAngle{ true }
+	, m_random()
 {
-	randomSeed();
 }
 
 Spline::Spline(std::initializer_list<sf::Vector2f> list)
@@ -214,6 +200,7 @@ Spline::Spline(const Spline& spline)
 	//, m_interpolatedVertices{}
 	//, m_interpolatedVerticesUnitTangents{}
 	//, m_outputVertices{}
+	, m_vertexBuffer{ spline.m_vertexBuffer }
 	, m_primitiveType{ spline.m_primitiveType }
 	, m_interpolationSteps{ spline.m_interpolationSteps }
 	, m_useBezier{ spline.m_useBezier }
@@ -221,6 +208,7 @@ Spline::Spline(const Spline& spline)
 	, m_showHandles{ spline.m_showHandles }
 	, m_lockHandleMirror{ spline.m_lockHandleMirror }
 	, m_lockHandleAngle{ spline.m_lockHandleAngle }
+	, m_random{ spline.m_random }
 {
 	m_vertices = spline.m_vertices;
 	m_interpolatedVertices = spline.m_interpolatedVertices;
@@ -247,6 +235,7 @@ Spline& Spline::operator=(const Spline& spline)
 	m_randomNormalOffsetRange = spline.m_randomNormalOffsetRange;
 	m_interpolatedVerticesUnitTangents = spline.m_interpolatedVerticesUnitTangents;
 	m_outputVertices = spline.m_outputVertices;
+	m_vertexBuffer = spline.m_vertexBuffer;
 	m_primitiveType = spline.m_primitiveType;
 	m_interpolationSteps = spline.m_interpolationSteps;
 	m_useBezier = spline.m_useBezier;
@@ -254,6 +243,7 @@ Spline& Spline::operator=(const Spline& spline)
 	m_showHandles = spline.m_showHandles;
 	m_lockHandleMirror = spline.m_lockHandleMirror;
 	m_lockHandleAngle = spline.m_lockHandleAngle;
+	m_random = spline.m_random;
 
 	return *this;
 }
@@ -569,6 +559,11 @@ void Spline::setRandomNormalOffsetsActivated(const bool randomNormalOffsetsActiv
 	m_isRandomNormalOffsetsActivated = randomNormalOffsetsActivated;
 }
 
+void Spline::setSeed(const std::uint64_t seed)
+{
+	m_random.setSeed(seed);
+}
+
 void Spline::setThickCornerType(const ThickCornerType thickCornerType)
 {
 	m_thickCornerType = thickCornerType;
@@ -825,6 +820,11 @@ void Spline::setHandlesVisible(const bool handlesVisible)
 	m_showHandles = handlesVisible;
 }
 
+void Spline::setUseVertexBuffer(const bool useVertexBuffer, const sf::VertexBuffer::Usage usage)
+{
+	m_vertexBuffer.setEnabled(useVertexBuffer, usage);
+}
+
 void Spline::setColor(const sf::Color color)
 {
 	m_color = color;
@@ -941,7 +941,7 @@ void Spline::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
 	states.texture = nullptr;
 	if (!m_outputVertices.empty())
-		target.draw(m_outputVertices.data(), m_outputVertices.size(), (priv_isThick() ? thickPrimitiveType : m_primitiveType), states);
+		m_vertexBuffer.draw(target, m_outputVertices, (priv_isThick() ? thickPrimitiveType : m_primitiveType), states);
 	if (m_showHandles && !m_handlesVertices.empty())
 		target.draw(m_handlesVertices.data(), m_handlesVertices.size(), sf::PrimitiveType::Lines, states);
 }
@@ -988,6 +988,7 @@ std::size_t Spline::priv_getInterpolatedIndex(const std::size_t interpolationOff
 
 void Spline::priv_updateOutputVertices()
 {
+	m_vertexBuffer.invalidate();
 	if (!priv_isThick())
 	{
 		m_outputVertices.resize(m_interpolatedVertices.size());
@@ -1026,7 +1027,7 @@ void Spline::priv_updateOutputVertices()
 			{
 				const sf::Vector2f normalUnit{ vectorNormal(tangentUnit) };
 				const float randomNormalOffsetRange{ m_randomNormalOffsetRange * linearInterpolation(currentVertex->randomNormalOffsetRange, nextVertex->randomNormalOffsetRange, vertexRatio) };
-				sf::Vector2f randomOffset{ normalUnit * (isConsideredZero(randomNormalOffsetRange) ? 0.f : randomValue(randomNormalOffsetRange)) };
+				sf::Vector2f randomOffset{ normalUnit * (isConsideredZero(randomNormalOffsetRange) ? 0.f : m_random.getFloat(0.f, randomNormalOffsetRange)) };
 				const bool randomOffsetIsCentered{ true };
 				if (randomOffsetIsCentered)
 					randomOffset -= normalUnit * (randomNormalOffsetRange / 2.f);
@@ -1138,7 +1139,7 @@ void Spline::priv_updateOutputVertices()
 			if (m_isRandomNormalOffsetsActivated)
 			{
 				const float randomNormalOffsetRange{ m_randomNormalOffsetRange * linearInterpolation(currentVertex->randomNormalOffsetRange, nextVertex->randomNormalOffsetRange, vertexRatio) };
-				randomOffset = normalUnit * (isConsideredZero(randomNormalOffsetRange) ? 0.f : randomValue(randomNormalOffsetRange));
+				randomOffset = normalUnit * (isConsideredZero(randomNormalOffsetRange) ? 0.f : m_random.getFloat(0.f, randomNormalOffsetRange));
 				const bool randomOffsetIsCentered{ true };
 				if (randomOffsetIsCentered)
 					randomOffset -= normalUnit * (randomNormalOffsetRange / 2.f);
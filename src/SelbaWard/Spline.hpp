@@ -34,6 +34,8 @@
 #define SELBAWARD_SPLINE_HPP
 
 #include "Common.hpp"
+#include "VertexBufferCache.hpp"
+#include "Random.hpp"
 
 namespace selbaward
 {
@@ -100,6 +102,7 @@ public:
 
 	void setRandomNormalOffsetsActivated(bool randomNormalOffsetsActivated);
 	bool getRandomNormalOffsetsActivated() const;
+	void setSeed(std::uint64_t seed); // seeds this spline's random number generator (used for random normal offsets) for reproducible results
 
 	void setThickCornerType(ThickCornerType cornerType);
 	ThickCornerType getThickCornerType() const;
@@ -154,6 +157,9 @@ public:
 	void setHandlesVisible(bool handlesVisible = true);
 	bool getHandlesVisible() const;
 
+	void setUseVertexBuffer(bool useVertexBuffer, sf::VertexBuffer::Usage usage = sf::VertexBuffer::Usage::Static); // keeps the output vertices on the GPU, re-uploading them only after an update (vertices are drawn directly if vertex buffers are unavailable). handles are always drawn directly
+	bool getUseVertexBuffer() const;
+
 	template <class T>
 	void setThickness(T thickness);
 	float getThickness() const;
@@ -222,6 +228,7 @@ private:
 	std::vector<sf::Vertex> m_interpolatedVertices;
 	std::vector<sf::Vector2f> m_interpolatedVerticesUnitTangents;
 	std::vector<sf::Vertex> m_outputVertices;
+	mutable VertexBufferCache m_vertexBuffer;
 	sf::PrimitiveType m_primitiveType;
 	std::size_t m_interpolationSteps;
 	bool m_useBezier;
@@ -230,6 +237,7 @@ private:
 	bool m_showHandles;
 	bool m_lockHandleMirror;
 	bool m_lockHandleAngle;
+	Random m_random;
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 	bool priv_isValidVertexIndex(std::size_t vertexIndex) const;
@@ -349,6 +357,11 @@ inline bool Spline::getHandlesVisible() const
 	return m_showHandles;
 }
 
+inline bool Spline::getUseVertexBuffer() const
+{
+	return m_vertexBuffer.getEnabled();
+}
+
 inline sf::Color Spline::getColor() const
 {
 	return m_color;
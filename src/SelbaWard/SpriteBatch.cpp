@@ -33,6 +33,22 @@
 #include "SpriteBatch.hpp"
 
 #include <assert.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstdint>
+#include <limits>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+// SSE2 is always available on x86-64 (and on 32-bit x86 when the compiler targets it). define SELBAWARD_NO_SIMD to use only the scalar code
+#if !defined(SELBAWARD_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SELBAWARD_SPRITEBATCH_SSE2
+#include <emmintrin.h>
+#endif // SSE2
 
 namespace
 {
@@ -40,12 +56,135 @@ namespace
 const std::string exceptionPrefix{ "Sprite Batch: " };
 
 constexpr std::size_t numberOfVerticesPerQuad{ 6u };
+constexpr std::size_t defaultParallelThreshold{ 32768u };
+constexpr std::size_t defaultParallelGrainSize{ 16384u };
+constexpr std::size_t maxInsertionSortShiftsPerSprite{ 8u }; // an insertion sort of the previous key order that needs more shifts than this (on average) is abandoned for a radix sort
+
+// an unsigned integer that sorts in the same order as the float (-0 and +0 are treated as equal)
+inline std::uint32_t sortableKey(float key)
+{
+	if (key == 0.f)
+		key = 0.f;
+	std::uint32_t bits;
+	std::memcpy(&bits, &key, sizeof(bits));
+	return ((bits & 0x80000000u) != 0u) ? ~bits : (bits | 0x80000000u);
+}
+
+#ifdef SELBAWARD_SPRITEBATCH_SSE2
+constexpr std::size_t numberOfQuadsPerBlock{ 4u }; // one quad per SSE lane
+constexpr std::size_t numberOfFloatsPerVertex{ sizeof(sf::Vertex) / sizeof(float) };
+constexpr std::size_t numberOfFloatsPerBlock{ numberOfQuadsPerBlock * numberOfVerticesPerQuad * numberOfFloatsPerVertex };
+constexpr std::size_t streamingThreshold{ 4u * 1024u * 1024u }; // bytes of vertices above which they bypass the cache (they would not fit anyway)
+static_assert(sizeof(sf::Vertex) == sizeof(float) * 5u, "sf::Vertex is expected to be position (2 floats), color (4 bytes) and texCoords (2 floats)");
+static_assert(numberOfFloatsPerBlock % 4u == 0u, "a block of quads is expected to be a whole number of SSE registers");
+
+// loads the vectors of four (possibly scattered) sprites; x and y receive one sprite in each lane
+inline void loadVectors(const sf::Vector2f* const vectors, const std::size_t(&indices)[numberOfQuadsPerBlock], __m128& x, __m128& y)
+{
+	const __m128 first{ _mm_loadh_pi(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(vectors + indices[0u]))), reinterpret_cast<const __m64*>(vectors + indices[1u])) };
+	const __m128 second{ _mm_loadh_pi(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(vectors + indices[2u]))), reinterpret_cast<const __m64*>(vectors + indices[3u])) };
+	x = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+	y = _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+// the components of a quad's vertices with one quad in each lane
+struct QuadComponents
+{
+	__m128 x[4u]; // corners: top-left, bottom-left, bottom-right and top-right
+	__m128 y[4u];
+	__m128 color;
+	__m128 left;
+	__m128 top;
+	__m128 right;
+	__m128 bottom;
+};
+
+// lane "Lane" of a, b, c and d
+template <std::size_t Lane>
+inline __m128 gatherLane(const __m128 a, const __m128 b, const __m128 c, const __m128 d)
+{
+	if constexpr (Lane == 0u)
+		return _mm_movelh_ps(_mm_unpacklo_ps(a, b), _mm_unpacklo_ps(c, d));
+	else if constexpr (Lane == 1u)
+		return _mm_movehl_ps(_mm_unpacklo_ps(c, d), _mm_unpacklo_ps(a, b));
+	else if constexpr (Lane == 2u)
+		return _mm_movelh_ps(_mm_unpackhi_ps(a, b), _mm_unpackhi_ps(c, d));
+	else
+		return _mm_movehl_ps(_mm_unpackhi_ps(c, d), _mm_unpackhi_ps(a, b));
+}
+
+inline void storeRegister(float* const destination, const __m128 value, const bool isStreaming)
+{
+	if (isStreaming)
+		_mm_stream_ps(destination, value);
+	else
+		_mm_storeu_ps(destination, value);
+}
+
+// a quad is 30 floats: (x, y, color, u, v) for corners 0, 1, 2, 0, 2, 3. four quads are 30 whole registers: quads in even lanes start on a register boundary
+// and quads in odd lanes start halfway through one so each writes the seven whole registers it has to itself and the neighbours share a register between them
+template <std::size_t Lane>
+inline void storeQuad(float* const destination, const QuadComponents& q, const bool isStreaming)
+{
+	if constexpr (Lane % 2u == 0u)
+	{
+		storeRegister(destination, gatherLane<Lane>(q.x[0u], q.y[0u], q.color, q.left), isStreaming);
+		storeRegister(destination + 4u, gatherLane<Lane>(q.top, q.x[1u], q.y[1u], q.color), isStreaming);
+		storeRegister(destination + 8u, gatherLane<Lane>(q.left, q.bottom, q.x[2u], q.y[2u]), isStreaming);
+		storeRegister(destination + 12u, gatherLane<Lane>(q.color, q.right, q.bottom, q.x[0u]), isStreaming);
+		storeRegister(destination + 16u, gatherLane<Lane>(q.y[0u], q.color, q.left, q.top), isStreaming);
+		storeRegister(destination + 20u, gatherLane<Lane>(q.x[2u], q.y[2u], q.color, q.right), isStreaming);
+		storeRegister(destination + 24u, gatherLane<Lane>(q.bottom, q.x[3u], q.y[3u], q.color), isStreaming);
+		// last two floats (right, top) are shared with the start of the next quad (x, y)
+		const __m128 end{ (Lane == 0u) ? _mm_unpacklo_ps(q.right, q.top) : _mm_unpackhi_ps(q.right, q.top) };
+		const __m128 start{ (Lane == 0u) ? _mm_unpacklo_ps(q.x[0u], q.y[0u]) : _mm_unpackhi_ps(q.x[0u], q.y[0u]) };
+		storeRegister(destination + 28u, _mm_shuffle_ps(end, start, _MM_SHUFFLE(3, 2, 1, 0)), isStreaming);
+	}
+	else
+	{
+		// starts two floats before "destination"
+		storeRegister(destination, gatherLane<Lane>(q.color, q.left, q.top, q.x[1u]), isStreaming);
+		storeRegister(destination + 4u, gatherLane<Lane>(q.y[1u], q.color, q.left, q.bottom), isStreaming);
+		storeRegister(destination + 8u, gatherLane<Lane>(q.x[2u], q.y[2u], q.color, q.right), isStreaming);
+		storeRegister(destination + 12u, gatherLane<Lane>(q.bottom, q.x[0u], q.y[0u], q.color), isStreaming);
+		storeRegister(destination + 16u, gatherLane<Lane>(q.left, q.top, q.x[2u], q.y[2u]), isStreaming);
+		storeRegister(destination + 20u, gatherLane<Lane>(q.color, q.right, q.bottom, q.x[3u]), isStreaming);
+		storeRegister(destination + 24u, gatherLane<Lane>(q.y[3u], q.color, q.right, q.top), isStreaming);
+	}
+}
+#endif // SELBAWARD_SPRITEBATCH_SSE2
 
 } // namespace
 
 namespace selbaward
 {
 
+// a fixed set of threads that help the calling thread work through numbered tasks
+class SpriteBatch::WorkerPool
+{
+public:
+	explicit WorkerPool(std::size_t numberOfWorkers);
+	~WorkerPool();
+	std::size_t getNumberOfWorkers() const;
+	void run(std::size_t numberOfTasks, const std::function<void(std::size_t)>& task); // calls task(i) for every i in [0, numberOfTasks) and returns when all have finished
+
+private:
+	std::mutex m_runMutex; // one run at a time (copies of a batch share a pool and may be drawn from different threads)
+	std::mutex m_mutex;
+	std::condition_variable m_runStarted;
+	std::condition_variable m_runFinished;
+	std::vector<std::thread> m_workers;
+	const std::function<void(std::size_t)>* m_task;
+	std::size_t m_numberOfTasks;
+	std::atomic<std::size_t> m_nextTask;
+	std::size_t m_numberOfBusyWorkers;
+	std::size_t m_runNumber;
+	bool m_isStopping;
+
+	void priv_work();
+	void priv_runTasks();
+};
+
 SpriteBatch::SpriteBatch()
 	: m_texture{ nullptr }
 	, m_orderFunction{ nullptr }
@@ -53,6 +192,17 @@ SpriteBatch::SpriteBatch()
 	, m_sprites()
 	, m_isGlobalUpdateRequired { false }
 	, m_vertices()
+	, m_orderSprites()
+	, m_workerPool()
+	, m_parallelThreshold{ defaultParallelThreshold }
+	, m_parallelGrainSize{ defaultParallelGrainSize }
+	, m_useKeyOrder{ false }
+	, m_isOrderUpdateRequired{ true }
+	, m_orderSpriteIndices()
+	, m_orderQuadIndices()
+	, m_isSpriteManuallyOrdered()
+	, m_keyOrderPairs()
+	, m_radixSortScratch()
 {
 
 }
@@ -74,6 +224,7 @@ void SpriteBatch::setNumberOfSprites(const std::size_t numberOfSprites)
 
 	m_sprites.resize(numberOfSprites);
 	m_isGlobalUpdateRequired = true;
+	m_isOrderUpdateRequired = true;
 }
 
 std::size_t SpriteBatch::getNumberOfSprites() const
@@ -88,8 +239,9 @@ std::size_t SpriteBatch::insertSprite(std::size_t insertIndex, const std::size_t
 
 	if (insertIndex > m_sprites.size())
 		insertIndex = m_sprites.size();
-	m_sprites.insert(m_sprites.begin() + insertIndex, numberOfSprites, Sprite{ false, sprite });
+	m_sprites.insert(insertIndex, numberOfSprites, sprite);
 	m_isGlobalUpdateRequired = true;
+	m_isOrderUpdateRequired = true;
 	return m_sprites.size();
 }
 
@@ -113,8 +265,9 @@ std::size_t SpriteBatch::removeSprite(const std::size_t removeIndex, const std::
 	std::size_t endIndex{ removeIndex + numberOfSprites };
 	if (endIndex > m_sprites.size())
 		endIndex = m_sprites.size();
-	m_sprites.erase(m_sprites.begin() + removeIndex, m_sprites.begin() + endIndex);
+	m_sprites.erase(removeIndex, endIndex);
 	m_isGlobalUpdateRequired = true;
+	m_isOrderUpdateRequired = true;
 	return m_sprites.size();
 }
 
@@ -131,8 +284,9 @@ void SpriteBatch::batchSprites(const std::vector<sf::Sprite>& sprites)
 	const std::size_t numberOfSprites{ sprites.size() };
 	m_sprites.resize(numberOfSprites);
 	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
-		m_sprites[i] = { false, sprites[i] };
+		m_sprites.set(i, sprites[i]);
 	m_isGlobalUpdateRequired = true;
+	m_isOrderUpdateRequired = true;
 }
 
 void SpriteBatch::batchSprites(const std::vector<sf::Sprite*>& sprites)
@@ -140,83 +294,161 @@ void SpriteBatch::batchSprites(const std::vector<sf::Sprite*>& sprites)
 	const std::size_t numberOfSprites{ sprites.size() };
 	m_sprites.resize(numberOfSprites);
 	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
-		m_sprites[i] = { false, *sprites[i] };
+		m_sprites.set(i, *sprites[i]);
 	m_isGlobalUpdateRequired = true;
+	m_isOrderUpdateRequired = true;
 }
 
 void SpriteBatch::updateSprite(const std::size_t index, const sf::Sprite& sprite)
 {
 	priv_testIsIndexValid(index);
 
-	m_sprites[index].isUpdateRequired = true;
-	m_sprites[index].sprite = sprite;
+	m_sprites.set(index, sprite);
+	m_sprites.requireUpdate(index);
 }
 
 sf::Sprite SpriteBatch::getSprite(const std::size_t index)
 {
 	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite;
+	return m_sprites.get(index, (m_texture != nullptr) ? *m_texture : sfmlEmptyTexture);
 }
 
 sf::Sprite SpriteBatch::operator[](const std::size_t index)
 {
-	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite;
+	return getSprite(index);
 }
 
 void SpriteBatch::setOrderFunction(const std::function<bool(const sf::Sprite* a, const sf::Sprite* b)>& orderFunction)
 {
 	m_orderFunction = orderFunction;
 	m_orderIndices.clear();
+	m_isGlobalUpdateRequired = true;
+	m_isOrderUpdateRequired = true;
 }
 
 void SpriteBatch::setOrderFunction()
 {
 	m_orderFunction = nullptr;
+	m_isGlobalUpdateRequired = true;
 }
 
 void SpriteBatch::setOrder(const std::vector<std::size_t>& orderIndices)
 {
 	m_orderIndices = orderIndices;
+	m_isGlobalUpdateRequired = true;
+	m_isOrderUpdateRequired = true;
 }
 
 void SpriteBatch::setOrder()
 {
 	m_orderIndices.clear();
+	m_isGlobalUpdateRequired = true;
+	m_isOrderUpdateRequired = true;
 }
 
 void SpriteBatch::clearAllOrdering()
 {
 	setOrderFunction();
 	setOrder();
+	setUseKeyOrder(false);
+}
+
+void SpriteBatch::setUseKeyOrder(const bool useKeyOrder)
+{
+	if (useKeyOrder == m_useKeyOrder)
+		return;
+
+	m_useKeyOrder = useKeyOrder;
+	m_isGlobalUpdateRequired = true;
+	m_isOrderUpdateRequired = true;
+}
+
+bool SpriteBatch::getUseKeyOrder() const
+{
+	return m_useKeyOrder;
+}
+
+void SpriteBatch::setKey(const std::size_t index, const float key)
+{
+	priv_testIsIndexValid(index);
+	if (key == m_sprites.keys[index])
+		return;
+
+	m_sprites.keys[index] = key;
+	if (priv_isKeyOrdered())
+		m_isOrderUpdateRequired = true;
+}
+
+float SpriteBatch::getKey(const std::size_t index) const
+{
+	priv_testIsIndexValid(index);
+	return m_sprites.keys[index];
+}
+
+void SpriteBatch::setNumberOfThreads(std::size_t numberOfThreads)
+{
+	if (numberOfThreads == 0u)
+		numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	if (numberOfThreads == getNumberOfThreads())
+		return;
+
+	if (numberOfThreads == 1u)
+		m_workerPool.reset();
+	else
+		m_workerPool = std::make_shared<WorkerPool>(numberOfThreads - 1u);
+}
+
+std::size_t SpriteBatch::getNumberOfThreads() const
+{
+	return (m_workerPool == nullptr) ? 1u : m_workerPool->getNumberOfWorkers() + 1u;
+}
+
+void SpriteBatch::setParallelThreshold(const std::size_t numberOfSprites)
+{
+	m_parallelThreshold = numberOfSprites;
+}
+
+std::size_t SpriteBatch::getParallelThreshold() const
+{
+	return m_parallelThreshold;
+}
+
+void SpriteBatch::setParallelGrainSize(const std::size_t numberOfSprites)
+{
+	m_parallelGrainSize = std::max((numberOfSprites + 3u) / 4u * 4u, std::size_t{ 4u }); // tasks start on a four-quad (SIMD) block so that each stays aligned
+}
+
+std::size_t SpriteBatch::getParallelGrainSize() const
+{
+	return m_parallelGrainSize;
 }
 
 void SpriteBatch::setPosition(const std::size_t index, const sf::Vector2f position)
 {
 	priv_testIsIndexValid(index);
-	m_sprites[index].sprite.setPosition(position);
-	m_sprites[index].isUpdateRequired = true;
+	m_sprites.positions[index] = position;
+	m_sprites.requireUpdate(index);
 }
 
 void SpriteBatch::setOrigin(const std::size_t index, const sf::Vector2f origin)
 {
 	priv_testIsIndexValid(index);
-	m_sprites[index].sprite.setOrigin(origin);
-	m_sprites[index].isUpdateRequired = true;
+	m_sprites.origins[index] = origin;
+	m_sprites.requireUpdate(index);
 }
 
 void SpriteBatch::setRotation(const std::size_t index, const float rotation)
 {
 	priv_testIsIndexValid(index);
-	m_sprites[index].sprite.setRotation(sf::degrees(rotation));
-	m_sprites[index].isUpdateRequired = true;
+	m_sprites.setRotation(index, sf::degrees(rotation).wrapUnsigned());
+	m_sprites.requireUpdate(index);
 }
 
 void SpriteBatch::setScale(const std::size_t index, const sf::Vector2f scale)
 {
 	priv_testIsIndexValid(index);
-	m_sprites[index].sprite.setScale(scale);
-	m_sprites[index].isUpdateRequired = true;
+	m_sprites.scales[index] = scale;
+	m_sprites.requireUpdate(index);
 }
 
 void SpriteBatch::setScale(const std::size_t index, const float scale)
@@ -227,36 +459,36 @@ void SpriteBatch::setScale(const std::size_t index, const float scale)
 void SpriteBatch::setTextureRect(const std::size_t index, const sf::IntRect textureRect)
 {
 	priv_testIsIndexValid(index);
-	m_sprites[index].sprite.setTextureRect(textureRect);
-	m_sprites[index].isUpdateRequired = true;
+	m_sprites.textureRects[index] = textureRect;
+	m_sprites.requireUpdate(index);
 }
 
 void SpriteBatch::setColor(const std::size_t index, const sf::Color& color)
 {
 	priv_testIsIndexValid(index);
-	m_sprites[index].sprite.setColor(color);
-	m_sprites[index].isUpdateRequired = true;
+	m_sprites.colors[index] = color;
+	m_sprites.requireUpdate(index);
 }
 
 void SpriteBatch::move(const std::size_t index, const sf::Vector2f offset)
 {
 	priv_testIsIndexValid(index);
-	m_sprites[index].sprite.move(offset);
-	m_sprites[index].isUpdateRequired = true;
+	m_sprites.positions[index] += offset;
+	m_sprites.requireUpdate(index);
 }
 
 void SpriteBatch::rotate(const std::size_t index, const sf::Angle angle)
 {
 	priv_testIsIndexValid(index);
-	m_sprites[index].sprite.rotate(angle);
-	m_sprites[index].isUpdateRequired = true;
+	m_sprites.setRotation(index, (m_sprites.rotations[index] + angle).wrapUnsigned());
+	m_sprites.requireUpdate(index);
 }
 
 void SpriteBatch::scale(const std::size_t index, const sf::Vector2f factor)
 {
 	priv_testIsIndexValid(index);
-	m_sprites[index].sprite.scale(factor);
-	m_sprites[index].isUpdateRequired = true;
+	m_sprites.scales[index] = { m_sprites.scales[index].x * factor.x, m_sprites.scales[index].y * factor.y };
+	m_sprites.requireUpdate(index);
 }
 
 void SpriteBatch::scale(const std::size_t index, const float factor)
@@ -267,81 +499,81 @@ void SpriteBatch::scale(const std::size_t index, const float factor)
 sf::Vector2f SpriteBatch::getPosition(const std::size_t index) const
 {
 	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getPosition();
+	return m_sprites.positions[index];
 }
 
 sf::Vector2f SpriteBatch::getOrigin(const std::size_t index) const
 {
 	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getOrigin();
+	return m_sprites.origins[index];
 }
 
 sf::Angle SpriteBatch::getRotation(const std::size_t index) const
 {
 	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getRotation();
+	return m_sprites.rotations[index];
 }
 
 sf::Vector2f SpriteBatch::getScale(const std::size_t index) const
 {
 	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getScale();
+	return m_sprites.scales[index];
 }
 
 sf::IntRect SpriteBatch::getTextureRect(const std::size_t index) const
 {
 	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getTextureRect();
+	return m_sprites.textureRects[index];
 }
 
 sf::Color SpriteBatch::getColor(const std::size_t index) const
 {
 	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getColor();
+	return m_sprites.colors[index];
 }
 
 sf::FloatRect SpriteBatch::getLocalBounds(const std::size_t index) const
 {
 	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getLocalBounds();
+	const sf::Vector2i size{ m_sprites.textureRects[index].size };
+	return{ { 0.f, 0.f }, { static_cast<float>(std::abs(size.x)), static_cast<float>(std::abs(size.y)) } };
 }
 
 sf::FloatRect SpriteBatch::getGlobalBounds(const std::size_t index) const
 {
-	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getGlobalBounds();
+	return getTransform(index).transformRect(getLocalBounds(index));
 }
 
 sf::Transform SpriteBatch::getTransform(const std::size_t index) const
 {
 	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getTransform();
+	return m_sprites.getTransform(index);
 }
 
 sf::Transform SpriteBatch::getInverseTransform(const std::size_t index) const
 {
-	priv_testIsIndexValid(index);
-	return m_sprites[index].sprite.getInverseTransform();
+	return getTransform(index).getInverse();
 }
 
 void SpriteBatch::move(const sf::Vector2f offset)
 {
-	for (auto& sprite : m_sprites)
-		sprite.sprite.move(offset);
+	for (auto& position : m_sprites.positions)
+		position += offset;
 	m_isGlobalUpdateRequired = true;
 }
 
 void SpriteBatch::rotate(const sf::Angle angle)
 {
-	for (auto& sprite : m_sprites)
-		sprite.sprite.rotate(angle);
+	const std::size_t numberOfSprites{ m_sprites.size() };
+	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+		m_sprites.setRotation(i, (m_sprites.rotations[i] + angle).wrapUnsigned());
 	m_isGlobalUpdateRequired = true;
 }
 
 void SpriteBatch::scale(const sf::Vector2f factor)
 {
-	for (auto& sprite : m_sprites)
-		sprite.sprite.scale(factor);
+	for (auto& scale : m_sprites.scales)
+		scale = { scale.x * factor.x, scale.y * factor.y };
 	m_isGlobalUpdateRequired = true;
 }
 
@@ -351,6 +583,23 @@ void SpriteBatch::scale(const float factor)
 	m_isGlobalUpdateRequired = true;
 }
 
+void SpriteBatch::appendVertices(VertexSink& sink, sf::RenderStates states) const
+{
+	if ((m_isGlobalUpdateRequired) || (priv_isOrderCached() ? m_isOrderUpdateRequired : (m_orderFunction != nullptr)))
+		priv_updateAll();
+	else
+		priv_updateRequired();
+
+	states.texture = m_texture;
+	sink.append(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+}
+
+void SpriteBatch::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
+{
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
+
 
 
 
@@ -370,15 +619,195 @@ void SpriteBatch::scale(const float factor)
 
 // PRIVATE
 
-void SpriteBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const
+SpriteBatch::WorkerPool::WorkerPool(const std::size_t numberOfWorkers)
+	: m_runMutex()
+	, m_mutex()
+	, m_runStarted()
+	, m_runFinished()
+	, m_workers()
+	, m_task{ nullptr }
+	, m_numberOfTasks{ 0u }
+	, m_nextTask{ 0u }
+	, m_numberOfBusyWorkers{ 0u }
+	, m_runNumber{ 0u }
+	, m_isStopping{ false }
 {
-	if ((m_orderFunction != nullptr) || (m_isGlobalUpdateRequired) || (!m_orderIndices.empty()))
-		priv_updateAll();
-	else
-		priv_updateRequired();
+	m_workers.reserve(numberOfWorkers);
+	for (std::size_t i{ 0u }; i < numberOfWorkers; ++i)
+		m_workers.emplace_back(&WorkerPool::priv_work, this);
+}
 
-	states.texture = m_texture;
-	target.draw(m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states);
+SpriteBatch::WorkerPool::~WorkerPool()
+{
+	{
+		const std::lock_guard<std::mutex> lock{ m_mutex };
+		m_isStopping = true;
+	}
+	m_runStarted.notify_all();
+	for (auto& worker : m_workers)
+		worker.join();
+}
+
+std::size_t SpriteBatch::WorkerPool::getNumberOfWorkers() const
+{
+	return m_workers.size();
+}
+
+void SpriteBatch::WorkerPool::run(const std::size_t numberOfTasks, const std::function<void(std::size_t)>& task)
+{
+	const std::lock_guard<std::mutex> runLock{ m_runMutex };
+	{
+		const std::lock_guard<std::mutex> lock{ m_mutex };
+		m_task = &task;
+		m_numberOfTasks = numberOfTasks;
+		m_nextTask = 0u;
+		m_numberOfBusyWorkers = m_workers.size();
+		++m_runNumber;
+	}
+	m_runStarted.notify_all();
+
+	priv_runTasks(); // the calling thread works too
+
+	std::unique_lock<std::mutex> lock{ m_mutex };
+	m_runFinished.wait(lock, [this]() { return m_numberOfBusyWorkers == 0u; });
+	m_task = nullptr;
+}
+
+void SpriteBatch::WorkerPool::priv_work()
+{
+	std::size_t runNumber{ 0u };
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock{ m_mutex };
+			m_runStarted.wait(lock, [&]() { return m_isStopping || (m_runNumber != runNumber); });
+			if (m_isStopping)
+				return;
+			runNumber = m_runNumber;
+		}
+
+		priv_runTasks();
+
+		{
+			const std::lock_guard<std::mutex> lock{ m_mutex };
+			--m_numberOfBusyWorkers;
+		}
+		m_runFinished.notify_one();
+	}
+}
+
+void SpriteBatch::WorkerPool::priv_runTasks()
+{
+	for (std::size_t i{ m_nextTask++ }; i < m_numberOfTasks; i = m_nextTask++)
+		(*m_task)(i);
+}
+
+std::size_t SpriteBatch::Sprites::size() const
+{
+	return positions.size();
+}
+
+bool SpriteBatch::Sprites::empty() const
+{
+	return positions.empty();
+}
+
+void SpriteBatch::Sprites::resize(const std::size_t numberOfSprites)
+{
+	positions.resize(numberOfSprites);
+	origins.resize(numberOfSprites);
+	rotations.resize(numberOfSprites);
+	rotationVectors.resize(numberOfSprites, { 1.f, 0.f });
+	scales.resize(numberOfSprites, { 1.f, 1.f });
+	textureRects.resize(numberOfSprites);
+	colors.resize(numberOfSprites, sf::Color::White);
+	keys.resize(numberOfSprites, 0.f);
+	isUpdateRequired.resize(numberOfSprites, false);
+}
+
+void SpriteBatch::Sprites::insert(const std::size_t index, const std::size_t numberOfSprites, const sf::Sprite& sprite)
+{
+	positions.insert(positions.begin() + index, numberOfSprites, sprite.getPosition());
+	origins.insert(origins.begin() + index, numberOfSprites, sprite.getOrigin());
+	rotations.insert(rotations.begin() + index, numberOfSprites, sprite.getRotation());
+	rotationVectors.insert(rotationVectors.begin() + index, numberOfSprites, {});
+	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+		setRotation(index + i, sprite.getRotation());
+	scales.insert(scales.begin() + index, numberOfSprites, sprite.getScale());
+	textureRects.insert(textureRects.begin() + index, numberOfSprites, sprite.getTextureRect());
+	colors.insert(colors.begin() + index, numberOfSprites, sprite.getColor());
+	keys.insert(keys.begin() + index, numberOfSprites, 0.f);
+	isUpdateRequired.insert(isUpdateRequired.begin() + index, numberOfSprites, false);
+}
+
+void SpriteBatch::Sprites::erase(const std::size_t beginIndex, const std::size_t endIndex)
+{
+	positions.erase(positions.begin() + beginIndex, positions.begin() + endIndex);
+	origins.erase(origins.begin() + beginIndex, origins.begin() + endIndex);
+	rotations.erase(rotations.begin() + beginIndex, rotations.begin() + endIndex);
+	rotationVectors.erase(rotationVectors.begin() + beginIndex, rotationVectors.begin() + endIndex);
+	scales.erase(scales.begin() + beginIndex, scales.begin() + endIndex);
+	textureRects.erase(textureRects.begin() + beginIndex, textureRects.begin() + endIndex);
+	colors.erase(colors.begin() + beginIndex, colors.begin() + endIndex);
+	keys.erase(keys.begin() + beginIndex, keys.begin() + endIndex);
+	isUpdateRequired.erase(isUpdateRequired.begin() + beginIndex, isUpdateRequired.begin() + endIndex);
+}
+
+void SpriteBatch::Sprites::requireUpdate(const std::size_t index)
+{
+	isUpdateRequired[index] = true;
+	isAnyUpdateRequired = true;
+}
+
+void SpriteBatch::Sprites::set(const std::size_t index, const sf::Sprite& sprite)
+{
+	positions[index] = sprite.getPosition();
+	origins[index] = sprite.getOrigin();
+	setRotation(index, sprite.getRotation());
+	scales[index] = sprite.getScale();
+	textureRects[index] = sprite.getTextureRect();
+	colors[index] = sprite.getColor();
+}
+
+void SpriteBatch::Sprites::setRotation(const std::size_t index, const sf::Angle rotation)
+{
+	rotations[index] = rotation;
+	const float angle{ -rotation.asRadians() };
+	rotationVectors[index] = { std::cos(angle), std::sin(angle) };
+}
+
+sf::Sprite SpriteBatch::Sprites::get(const std::size_t index, const sf::Texture& texture) const
+{
+	sf::Sprite sprite(texture, textureRects[index]);
+	sprite.setPosition(positions[index]);
+	sprite.setOrigin(origins[index]);
+	sprite.setRotation(rotations[index]);
+	sprite.setScale(scales[index]);
+	sprite.setColor(colors[index]);
+	return sprite;
+}
+
+sf::Transform SpriteBatch::Sprites::getTransform(const std::size_t index) const
+{
+	// matches sf::Transformable::getTransform
+	const float cosine{ rotationVectors[index].x };
+	const float sine{ rotationVectors[index].y };
+	const sf::Vector2f scale{ scales[index] };
+	const sf::Vector2f origin{ origins[index] };
+	const sf::Vector2f position{ positions[index] };
+	const float sxc{ scale.x * cosine };
+	const float syc{ scale.y * cosine };
+	const float sxs{ scale.x * sine };
+	const float sys{ scale.y * sine };
+	const float tx{ -origin.x * sxc - origin.y * sys + position.x };
+	const float ty{ origin.x * sxs - origin.y * syc + position.y };
+	return{ sxc, sys, tx, -sxs, syc, ty, 0.f, 0.f, 1.f };
+}
+
+void SpriteBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	RenderTargetVertexSink sink{ target };
+	appendVertices(sink, states);
 }
 
 void SpriteBatch::priv_testIsIndexValid(const std::size_t index) const
@@ -400,120 +829,300 @@ void SpriteBatch::priv_updateAll() const
 	const std::size_t numberOfSprites{ m_sprites.size() };
 	m_vertices.resize(numberOfSprites * numberOfVerticesPerQuad);
 
-	if (!m_orderIndices.empty())
+	if (priv_isOrderCached())
 	{
-		// create a vector of orig(ordered) indices
-		std::vector<std::size_t> origIndices(numberOfSprites);
+		if (m_isOrderUpdateRequired)
+			priv_updateOrder();
+		priv_updateAllQuads(m_orderSpriteIndices.data());
+	}
+	else if (m_orderFunction != nullptr)
+	{
+		// the order function compares sf::Sprites so they are re-created (once per sprite) from the stored arrays
+		m_orderSprites.clear();
+		m_orderSprites.reserve(numberOfSprites);
+		const sf::Texture& texture{ (m_texture != nullptr) ? *m_texture : sfmlEmptyTexture };
 		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
-			origIndices[i] = i;
+			m_orderSprites.push_back(m_sprites.get(i, texture));
 
-		// copy order indices in reverse
-		std::vector<std::size_t> orderIndices{ m_orderIndices };
-		std::sort(orderIndices.rbegin(), orderIndices.rend());
+		// create vector of pointers to sort
+		std::vector<const sf::Sprite*> pointers(numberOfSprites);
+		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+			pointers[i] = &(m_orderSprites[i]);
 
-		// remove all indices in order indices from orig(ordered) indices
-		for (auto& orderIndex : orderIndices)
-			origIndices.erase(origIndices.begin() + orderIndex);
+		// sort pointers using custom order function
+		std::sort(pointers.begin(), pointers.end(), m_orderFunction);
 
-		// rebuild order indices (copy) to contain order indices followed by remaining orig(ordered) indices
-		orderIndices.resize(numberOfSprites);
-		const std::size_t sizeOfOrderIndices{ m_orderIndices.size() };
+		// update quads
+		std::vector<std::size_t> orderIndices(numberOfSprites);
 		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+			orderIndices[i] = static_cast<std::size_t>(pointers[i] - m_orderSprites.data());
+		priv_updateAllQuads(orderIndices.data());
+	}
+	else
+	{
+		// update quads
+		priv_updateAllQuads();
+	}
+
+	m_sprites.isUpdateRequired.assign(numberOfSprites, false);
+	m_sprites.isAnyUpdateRequired = false;
+	m_isGlobalUpdateRequired = false;
+}
+
+void SpriteBatch::priv_updateRequired() const
+{
+	if (!m_sprites.isAnyUpdateRequired)
+		return;
+
+	const bool isOrderCached{ priv_isOrderCached() };
+	const std::size_t numberOfSprites{ m_sprites.size() };
+	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+	{
+		if (m_sprites.isUpdateRequired[i])
 		{
-			if (i < sizeOfOrderIndices)
-				orderIndices[i] = m_orderIndices[i];
-			else
-				orderIndices[i] = origIndices[i - sizeOfOrderIndices];
+			priv_updateQuad(isOrderCached ? m_orderQuadIndices[i] : i, i);
+			m_sprites.isUpdateRequired[i] = false;
 		}
+	}
+	m_sprites.isAnyUpdateRequired = false;
+}
 
-		// update quads
-		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+bool SpriteBatch::priv_isKeyOrdered() const
+{
+	return m_useKeyOrder && m_orderIndices.empty();
+}
+
+bool SpriteBatch::priv_isOrderCached() const
+{
+	return !m_orderIndices.empty() || m_useKeyOrder;
+}
+
+void SpriteBatch::priv_updateOrder() const
+{
+	if (!m_orderIndices.empty())
+		priv_updateManualOrder();
+	else
+		priv_updateKeyOrder();
+
+	const std::size_t numberOfSprites{ m_sprites.size() };
+	m_orderQuadIndices.resize(numberOfSprites);
+	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+		m_orderQuadIndices[m_orderSpriteIndices[i]] = i;
+	m_isOrderUpdateRequired = false;
+}
+
+void SpriteBatch::priv_updateManualOrder() const
+{
+	// the manually ordered sprites come first (indices that are out of range or repeated are ignored), followed by all of the other sprites in index order
+	const std::size_t numberOfSprites{ m_sprites.size() };
+	m_orderSpriteIndices.clear();
+	m_orderSpriteIndices.reserve(numberOfSprites);
+	m_isSpriteManuallyOrdered.assign(numberOfSprites, false);
+	for (const std::size_t orderIndex : m_orderIndices)
+	{
+		if ((orderIndex < numberOfSprites) && !m_isSpriteManuallyOrdered[orderIndex])
 		{
-			priv_updateQuad(i, &(m_sprites[orderIndices[i]].sprite));
-			m_sprites[i].isUpdateRequired = false; // this "i" doesn't need to match as we're clearing the update for all anyway
+			m_isSpriteManuallyOrdered[orderIndex] = true;
+			m_orderSpriteIndices.push_back(orderIndex);
 		}
 	}
-	else if (m_orderFunction != nullptr)
+	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
 	{
-		// create vector of pointers to sort
-		std::vector<sf::Sprite*> pointers(numberOfSprites);
-		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
-			pointers[i] = &(m_sprites[i].sprite);
+		if (!m_isSpriteManuallyOrdered[i])
+			m_orderSpriteIndices.push_back(i);
+	}
+}
 
-		// sort pointers using custom order function
-		std::sort(pointers.begin(), pointers.end(), m_orderFunction);
+void SpriteBatch::priv_updateKeyOrder() const
+{
+	// sorts (key, sprite index) pairs packed into 64-bit integers so that equal keys are ordered by sprite index
+	const std::size_t numberOfSprites{ m_sprites.size() };
+	assert(numberOfSprites <= std::numeric_limits<std::uint32_t>::max());
+	const auto pack = [&](const std::uint64_t spriteIndex) { return (static_cast<std::uint64_t>(sortableKey(m_sprites.keys[spriteIndex])) << 32u) | spriteIndex; };
 
-		// update quads
-		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+	// keys usually change a little each frame so the previous order is nearly sorted: insertion sort it (linear when it is already sorted).
+	// if it turns out to be far from sorted, radix sort from scratch instead
+	bool isSorted{ false };
+	if (m_keyOrderPairs.size() == numberOfSprites)
+	{
+		for (auto& pair : m_keyOrderPairs)
+			pair = pack(pair & 0xFFFFFFFFu);
+
+		const std::size_t maxNumberOfShifts{ numberOfSprites * maxInsertionSortShiftsPerSprite };
+		std::size_t numberOfShifts{ 0u };
+		isSorted = true;
+		for (std::size_t i{ 1u }; (i < numberOfSprites) && isSorted; ++i)
 		{
-			priv_updateQuad(i, pointers[i]);
-			m_sprites[i].isUpdateRequired = false;
+			const std::uint64_t pair{ m_keyOrderPairs[i] };
+			std::size_t j{ i };
+			for (; (j > 0u) && (pair < m_keyOrderPairs[j - 1u]); --j)
+				m_keyOrderPairs[j] = m_keyOrderPairs[j - 1u];
+			m_keyOrderPairs[j] = pair;
+			numberOfShifts += i - j;
+			isSorted = (numberOfShifts <= maxNumberOfShifts);
 		}
 	}
-	else
+	if (!isSorted)
 	{
-		// update quads
+		// LSD radix sort, a byte of the key at a time. it is stable and starts in sprite index order so equal keys stay in sprite index order
+		m_keyOrderPairs.resize(numberOfSprites);
+		m_radixSortScratch.resize(numberOfSprites);
+		std::size_t counts[4u][256u]{};
 		for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
 		{
-			priv_updateQuad(i, &(m_sprites[i].sprite));
-			m_sprites[i].isUpdateRequired = false;
+			m_keyOrderPairs[i] = pack(i);
+			for (std::size_t byte{ 0u }; byte < 4u; ++byte)
+				++counts[byte][(m_keyOrderPairs[i] >> (32u + byte * 8u)) & 0xFFu];
+		}
+		for (std::size_t byte{ 0u }; byte < 4u; ++byte)
+		{
+			const std::size_t shift{ 32u + byte * 8u };
+			if (counts[byte][(m_keyOrderPairs[0u] >> shift) & 0xFFu] == numberOfSprites)
+				continue; // every key has the same value in this byte
+			std::size_t offsets[256u];
+			std::size_t offset{ 0u };
+			for (std::size_t value{ 0u }; value < 256u; ++value)
+			{
+				offsets[value] = offset;
+				offset += counts[byte][value];
+			}
+			for (const std::uint64_t pair : m_keyOrderPairs)
+				m_radixSortScratch[offsets[(pair >> shift) & 0xFFu]++] = pair;
+			m_keyOrderPairs.swap(m_radixSortScratch);
 		}
 	}
 
-	m_isGlobalUpdateRequired = false;
+	m_orderSpriteIndices.resize(numberOfSprites);
+	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+		m_orderSpriteIndices[i] = static_cast<std::size_t>(m_keyOrderPairs[i] & 0xFFFFFFFFu);
 }
 
-void SpriteBatch::priv_updateRequired() const
+void SpriteBatch::priv_updateQuad(const std::size_t quadIndex, const std::size_t spriteIndex) const
+{
+	// the transform is computed in place (as sf::Transformable::getTransform would) from the sprite's arrays
+	const float cosine{ m_sprites.rotationVectors[spriteIndex].x };
+	const float sine{ m_sprites.rotationVectors[spriteIndex].y };
+	const sf::Vector2f scale{ m_sprites.scales[spriteIndex] };
+	const sf::Vector2f origin{ m_sprites.origins[spriteIndex] };
+	const sf::Vector2f position{ m_sprites.positions[spriteIndex] };
+	const float a{ scale.x * cosine };
+	const float b{ scale.y * sine };
+	const float c{ -scale.x * sine };
+	const float d{ scale.y * cosine };
+	const float tx{ -origin.x * a - origin.y * b + position.x };
+	const float ty{ -origin.x * c - origin.y * d + position.y };
+
+	const sf::IntRect rect{ m_sprites.textureRects[spriteIndex] };
+	const sf::Color color{ m_sprites.colors[spriteIndex] };
+	const sf::Vector2f size(rect.size);
+	const sf::Vector2f textureTopLeft(rect.position);
+	const sf::Vector2f textureBottomRight{ textureTopLeft + size };
+
+	sf::Vertex* const quad{ m_vertices.data() + quadIndex * numberOfVerticesPerQuad };
+	quad[0u] = { { tx, ty }, color, textureTopLeft };
+	quad[1u] = { { b * size.y + tx, d * size.y + ty }, color, { textureTopLeft.x, textureBottomRight.y } };
+	quad[2u] = { { a * size.x + b * size.y + tx, c * size.x + d * size.y + ty }, color, textureBottomRight };
+	quad[3u] = quad[0u];
+	quad[4u] = quad[2u];
+	quad[5u] = { { a * size.x + tx, c * size.x + ty }, color, { textureBottomRight.x, textureTopLeft.y } };
+}
+
+void SpriteBatch::priv_updateAllQuads(const std::size_t* const spriteIndices) const
 {
 	const std::size_t numberOfSprites{ m_sprites.size() };
-	for (std::size_t i{ 0u }; i < numberOfSprites; ++i)
+	if ((m_workerPool == nullptr) || (numberOfSprites < m_parallelThreshold))
 	{
-		if (m_sprites[i].isUpdateRequired)
-		{
-			priv_updateQuad(i, &(m_sprites[i].sprite));
-			m_sprites[i].isUpdateRequired = false;
-		}
+		priv_updateQuads(0u, numberOfSprites, spriteIndices);
+		return;
 	}
+
+	// each task is a separate range of quads (and so a separate range of vertices)
+	const std::size_t grainSize{ m_parallelGrainSize };
+	m_workerPool->run((numberOfSprites + grainSize - 1u) / grainSize, [&](const std::size_t task)
+	{
+		const std::size_t quadIndex{ task * grainSize };
+		priv_updateQuads(quadIndex, std::min(grainSize, numberOfSprites - quadIndex), spriteIndices);
+	});
 }
 
-void SpriteBatch::priv_updateQuad(const std::size_t quadIndex, const sf::Sprite* sprite) const
-{
-	const std::size_t startVertex{ quadIndex * numberOfVerticesPerQuad };
-
-	const sf::Transform transform{ sprite->getTransform() };
-	const sf::Color color{ sprite->getColor() };
-	const sf::IntRect rect{ sprite->getTextureRect() };
-
-	sf::Vector2f shapeTopLeft{ 0.f, 0.f };
-	sf::Vector2f shapeBottomRight(rect.size);
-	sf::Vector2f shapeTopRight{ shapeBottomRight.x, shapeTopLeft.y };
-	sf::Vector2f shapeBottomLeft{ shapeTopLeft.x, shapeBottomRight.y };
-	sf::Vector2f textureTopLeft(rect.position);
-	sf::Vector2f textureBottomRight{ textureTopLeft + shapeBottomRight };
-	sf::Vector2f textureTopRight{ textureBottomRight.x, textureTopLeft.y };
-	sf::Vector2f textureBottomLeft{ textureTopLeft.x, textureBottomRight.y };
-
-
-	shapeTopLeft = transform.transformPoint(shapeTopLeft);
-	shapeBottomRight = transform.transformPoint(shapeBottomRight);
-	shapeTopRight = transform.transformPoint(shapeTopRight);
-	shapeBottomLeft = transform.transformPoint(shapeBottomLeft);
-
-	m_vertices[startVertex + 0u].position = shapeTopLeft;
-	m_vertices[startVertex + 0u].texCoords = textureTopLeft;
-	m_vertices[startVertex + 0u].color = color;
-	m_vertices[startVertex + 1u].position = shapeBottomLeft;
-	m_vertices[startVertex + 1u].texCoords = textureBottomLeft;
-	m_vertices[startVertex + 1u].color = color;
-	m_vertices[startVertex + 2u].position = shapeBottomRight;
-	m_vertices[startVertex + 2u].texCoords = textureBottomRight;
-	m_vertices[startVertex + 2u].color = color;
-	m_vertices[startVertex + 5u].position = shapeTopRight;
-	m_vertices[startVertex + 5u].texCoords = textureTopRight;
-	m_vertices[startVertex + 5u].color = color;
-
-	m_vertices[startVertex + 3u] = m_vertices[startVertex + 0u];
-	m_vertices[startVertex + 4u] = m_vertices[startVertex + 2u];
+void SpriteBatch::priv_updateQuads(const std::size_t quadIndex, const std::size_t numberOfQuads, const std::size_t* const spriteIndices) const
+{
+	std::size_t i{ 0u };
+
+#ifdef SELBAWARD_SPRITEBATCH_SSE2
+	// four sprites at a time: one in each lane. the vertices of the four quads are transposed into whole registers and written directly (bypassing the cache for large batches)
+	const __m128 signBit{ _mm_set1_ps(-0.f) };
+	float* const destination{ reinterpret_cast<float*>(m_vertices.data() + quadIndex * numberOfVerticesPerQuad) };
+	const bool isAligned{ (reinterpret_cast<std::uintptr_t>(destination) % 16u) == 0u }; // true for every block if true for the first (a block is 480 bytes)
+	const bool isStreaming{ isAligned && (m_vertices.size() * sizeof(sf::Vertex) > streamingThreshold) }; // the whole batch, which may be updated in parts
+	for (; i + numberOfQuadsPerBlock <= numberOfQuads; i += numberOfQuadsPerBlock)
+	{
+		std::size_t indices[numberOfQuadsPerBlock];
+		for (std::size_t lane{ 0u }; lane < numberOfQuadsPerBlock; ++lane)
+			indices[lane] = (spriteIndices != nullptr) ? spriteIndices[quadIndex + i + lane] : quadIndex + i + lane;
+
+		__m128 cosine, sine, scaleX, scaleY, originX, originY, positionX, positionY;
+		loadVectors(m_sprites.rotationVectors.data(), indices, cosine, sine);
+		loadVectors(m_sprites.scales.data(), indices, scaleX, scaleY);
+		loadVectors(m_sprites.origins.data(), indices, originX, originY);
+		loadVectors(m_sprites.positions.data(), indices, positionX, positionY);
+
+		// same operations (and order) as priv_updateQuad so that the results are identical
+		const __m128 a{ _mm_mul_ps(scaleX, cosine) };
+		const __m128 b{ _mm_mul_ps(scaleY, sine) };
+		const __m128 c{ _mm_mul_ps(_mm_xor_ps(scaleX, signBit), sine) };
+		const __m128 d{ _mm_mul_ps(scaleY, cosine) };
+		const __m128 negativeOriginX{ _mm_xor_ps(originX, signBit) };
+		const __m128 tx{ _mm_add_ps(_mm_sub_ps(_mm_mul_ps(negativeOriginX, a), _mm_mul_ps(originY, b)), positionX) };
+		const __m128 ty{ _mm_add_ps(_mm_sub_ps(_mm_mul_ps(negativeOriginX, c), _mm_mul_ps(originY, d)), positionY) };
+
+		// texture rects (position x, position y, size x, size y) transposed so that each register holds one component of all four
+		__m128 rectLeft{ _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m_sprites.textureRects.data() + indices[0u]))) };
+		__m128 rectTop{ _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m_sprites.textureRects.data() + indices[1u]))) };
+		__m128 width{ _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m_sprites.textureRects.data() + indices[2u]))) };
+		__m128 height{ _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m_sprites.textureRects.data() + indices[3u]))) };
+		_MM_TRANSPOSE4_PS(rectLeft, rectTop, width, height);
+		const __m128 rectRight{ _mm_add_ps(rectLeft, width) };
+		const __m128 rectBottom{ _mm_add_ps(rectTop, height) };
+
+		std::int32_t colors[numberOfQuadsPerBlock]; // the bytes of each colour as they are laid out in a vertex
+		for (std::size_t lane{ 0u }; lane < numberOfQuadsPerBlock; ++lane)
+			std::memcpy(colors + lane, m_sprites.colors.data() + indices[lane], sizeof(std::int32_t));
+		const __m128 color{ _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(colors))) };
+
+		QuadComponents quads;
+		quads.color = color;
+		quads.left = rectLeft;
+		quads.top = rectTop;
+		quads.right = rectRight;
+		quads.bottom = rectBottom;
+		const __m128 bh{ _mm_mul_ps(b, height) };
+		const __m128 dh{ _mm_mul_ps(d, height) };
+		const __m128 aw{ _mm_mul_ps(a, width) };
+		const __m128 cw{ _mm_mul_ps(c, width) };
+		quads.x[0u] = tx;
+		quads.y[0u] = ty;
+		quads.x[1u] = _mm_add_ps(bh, tx);
+		quads.y[1u] = _mm_add_ps(dh, ty);
+		quads.x[2u] = _mm_add_ps(_mm_add_ps(aw, bh), tx);
+		quads.y[2u] = _mm_add_ps(_mm_add_ps(cw, dh), ty);
+		quads.x[3u] = _mm_add_ps(aw, tx);
+		quads.y[3u] = _mm_add_ps(cw, ty);
+
+		// written in order so that streaming stores fill whole cache lines
+		float* const blockDestination{ destination + i * numberOfVerticesPerQuad * numberOfFloatsPerVertex };
+		storeQuad<0u>(blockDestination, quads, isStreaming);
+		storeQuad<1u>(blockDestination + 32u, quads, isStreaming);
+		storeQuad<2u>(blockDestination + 60u, quads, isStreaming);
+		storeQuad<3u>(blockDestination + 92u, quads, isStreaming);
+	}
+	if (isStreaming)
+		_mm_sfence();
+#endif // SELBAWARD_SPRITEBATCH_SSE2
+
+	// remaining quads (or all of them without SIMD)
+	for (; i < numberOfQuads; ++i)
+		priv_updateQuad(quadIndex + i, (spriteIndices != nullptr) ? spriteIndices[quadIndex + i] : quadIndex + i);
 }
 
 } // namespace selbaward
@@ -34,11 +34,14 @@
 #define SELBAWARD_SPRITEBATCH_HPP
 
 #include "Common.hpp"
+#include "VertexSink.hpp"
 
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 
 namespace
 {
@@ -72,8 +75,8 @@ public:
 	void batchSprites(const std::vector<sf::Sprite*>& sprites); // copy entire vector of sprites (from the pointers) into batch and prepares it for entire update
 
 	void updateSprite(std::size_t index, const sf::Sprite& sprite);
-	sf::Sprite getSprite(std::size_t index); // this sf::Sprite is a copy, not access to the internally stored one!
-	sf::Sprite operator[](std::size_t index); // this sf::Sprite is a copy, not access to the internally stored one!
+	sf::Sprite getSprite(std::size_t index); // this sf::Sprite is re-created (using the batch's texture), not access to an internally stored one!
+	sf::Sprite operator[](std::size_t index); // this sf::Sprite is re-created (using the batch's texture), not access to an internally stored one!
 
 	void setOrderFunction(const std::function<bool(const sf::Sprite* a, const sf::Sprite* b)>& orderFunction); // sets order function and clears any manual order
 	void setOrderFunction(); // clears order function and but does not clear any manual order
@@ -81,7 +84,21 @@ public:
 	void setOrder(const std::vector<std::size_t>& orderIndices); // sets manual order, which overrides order function (but doesn't clear the order function)
 	void setOrder(); // clears manual order and reinstates order function, if available
 
-	void clearAllOrdering(); // clears order function and also the manual order
+	void clearAllOrdering(); // clears order function, key order and also the manual order
+
+	// key order: sprites are drawn in order of their keys (e.g. depth), lowest first, with equal keys in index order. the order is re-sorted only when a key or the number of sprites changes
+	void setUseKeyOrder(bool useKeyOrder); // manual order overrides key order, which overrides the order function (which is not cleared)
+	bool getUseKeyOrder() const;
+	void setKey(std::size_t index, float key);
+	float getKey(std::size_t index) const;
+
+	// parallel update (opt-in): when the entire batch is updated, its quads are generated by multiple threads
+	void setNumberOfThreads(std::size_t numberOfThreads); // includes the thread that draws. 1 (default) disables parallel update. 0 uses one thread per hardware thread
+	std::size_t getNumberOfThreads() const;
+	void setParallelThreshold(std::size_t numberOfSprites); // batches with fewer sprites are always updated by a single thread
+	std::size_t getParallelThreshold() const;
+	void setParallelGrainSize(std::size_t numberOfSprites); // sprites in each task given to a thread (rounded up to a multiple of 4)
+	std::size_t getParallelGrainSize() const;
 
 
 
@@ -128,6 +145,10 @@ public:
 	void scale(sf::Vector2f factor);
 	void scale(float factor); // scales both x and y by the same factor
 
+	// vertex sink
+	void appendVertices(VertexSink& sink, sf::RenderStates states = sf::RenderStates::Default) const; // submits what would be drawn to a sink instead of a render target
+	void appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform = sf::Transform::Identity) const; // appends what would be drawn as transformed triangles
+
 
 
 
@@ -149,26 +170,68 @@ public:
 
 
 private:
-	struct Sprite
+	// sprites are stored as a structure of arrays (element i of each array belongs to sprite i) so that quad generation reads only what it needs from contiguous memory
+	struct Sprites
 	{
-		bool isUpdateRequired{ false };
-		sf::Sprite sprite{ sfmlEmptyTexture };
+		std::vector<sf::Vector2f> positions;
+		std::vector<sf::Vector2f> origins;
+		std::vector<sf::Angle> rotations;
+		std::vector<sf::Vector2f> rotationVectors; // cosine and sine of the (negated) rotation, kept with the rotation so quad generation needs no trigonometry
+		std::vector<sf::Vector2f> scales;
+		std::vector<sf::IntRect> textureRects;
+		std::vector<sf::Color> colors;
+		std::vector<float> keys;
+		std::vector<bool> isUpdateRequired;
+		bool isAnyUpdateRequired{ false };
+
+		std::size_t size() const;
+		bool empty() const;
+		void resize(std::size_t numberOfSprites);
+		void insert(std::size_t index, std::size_t numberOfSprites, const sf::Sprite& sprite);
+		void erase(std::size_t beginIndex, std::size_t endIndex);
+		void requireUpdate(std::size_t index);
+		void set(std::size_t index, const sf::Sprite& sprite);
+		void setRotation(std::size_t index, sf::Angle rotation);
+		sf::Sprite get(std::size_t index, const sf::Texture& texture) const;
+		sf::Transform getTransform(std::size_t index) const;
 	};
 
+	class WorkerPool;
+
 	const sf::Texture* m_texture;
 
 	std::function<bool(const sf::Sprite* a, const sf::Sprite* b)> m_orderFunction;
 	std::vector<std::size_t> m_orderIndices;
 
-	mutable std::vector<Sprite> m_sprites;
+	mutable Sprites m_sprites;
 	mutable bool m_isGlobalUpdateRequired;
 	mutable std::vector<sf::Vertex> m_vertices;
+	mutable std::vector<sf::Sprite> m_orderSprites; // sprites re-created for the order function to compare
+
+	std::shared_ptr<WorkerPool> m_workerPool; // null unless updating in parallel. shared by copies of the batch
+	std::size_t m_parallelThreshold;
+	std::size_t m_parallelGrainSize;
+
+	bool m_useKeyOrder;
+	mutable bool m_isOrderUpdateRequired; // manual order and key order are resolved into the permutation below, which is only rebuilt when this is set
+	mutable std::vector<std::size_t> m_orderSpriteIndices; // sprite index of each quad
+	mutable std::vector<std::size_t> m_orderQuadIndices; // quad index of each sprite
+	mutable std::vector<bool> m_isSpriteManuallyOrdered; // marks sprites already placed by the manual order
+	mutable std::vector<std::uint64_t> m_keyOrderPairs; // (key, sprite index) of each quad packed so that they sort by key then by index. kept to start the next sort
+	mutable std::vector<std::uint64_t> m_radixSortScratch;
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 	void priv_testIsIndexValid(const std::size_t index) const;
 	void priv_updateAll() const;
 	void priv_updateRequired() const;
-	void priv_updateQuad(const std::size_t quadIndex, const sf::Sprite* sprite) const;
+	bool priv_isKeyOrdered() const;
+	bool priv_isOrderCached() const;
+	void priv_updateOrder() const;
+	void priv_updateManualOrder() const;
+	void priv_updateKeyOrder() const;
+	void priv_updateQuad(const std::size_t quadIndex, const std::size_t spriteIndex) const;
+	void priv_updateAllQuads(const std::size_t* const spriteIndices = nullptr) const;
+	void priv_updateQuads(const std::size_t quadIndex, const std::size_t numberOfQuads, const std::size_t* const spriteIndices = nullptr) const; // quad (quadIndex + i) is from sprite spriteIndices[quadIndex + i] or, without indices, sprite (quadIndex + i)
 };
 
 } // namespace selbaward
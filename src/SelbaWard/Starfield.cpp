@@ -32,30 +32,6 @@
 
 #include "Starfield.hpp"
 
-#include <random>
-#include <functional>
-
-namespace
-{
-
-std::mt19937 randomGenerator;
-std::uniform_int_distribution<unsigned short int> randomDistributionAlpha(1u, 255u);
-std::function <unsigned short int()> randomAlpha;
-
-inline void randomSeed()
-{
-	std::random_device rd;
-	randomGenerator.seed(rd());
-	randomAlpha = std::bind(randomDistributionAlpha, randomGenerator);
-}
-
-inline float randomValue(const float low, const float high)
-{
-	return std::uniform_real_distribution<float>{low, high}(randomGenerator);
-}
-
-} // namespace
-
 namespace selbaward
 {
 
@@ -64,8 +40,8 @@ Starfield::Starfield(const sf::Vector2f size, const unsigned int numberOfStars,
 	, m_vertices(numberOfStars)
 	, m_size(size)
 	, m_color(color)
+	, m_random()
 {
-	randomSeed();
 	regenerate();
 }
 
@@ -78,13 +54,13 @@ void Starfield::move(sf::Vector2f movement)
 
 		// wrap
 		if (vertex.position.x < 0)
-			vertex.position = { m_size.x, randomValue(0.f, m_size.y), };
+			vertex.position = { m_size.x, m_random.getFloat(0.f, m_size.y), };
 		else if (vertex.position.x > m_size.x)
-			vertex.position = { 0.f, randomValue(0.f, m_size.y), };
+			vertex.position = { 0.f, m_random.getFloat(0.f, m_size.y), };
 		if (vertex.position.y < 0)
-			vertex.position = { randomValue(0.f, m_size.x), m_size.y, };
+			vertex.position = { m_random.getFloat(0.f, m_size.x), m_size.y, };
 		else if (vertex.position.y > m_size.y)
-			vertex.position = { randomValue(0.f, m_size.x) , 0.f };
+			vertex.position = { m_random.getFloat(0.f, m_size.x) , 0.f };
 	}
 }
 
@@ -92,9 +68,9 @@ void Starfield::regenerate()
 {
 	for (auto& vertex : m_vertices)
 	{
-		vertex.position = { randomValue(0.f, m_size.x), randomValue(0.f, m_size.y) };
+		vertex.position = { m_random.getFloat(0.f, m_size.x), m_random.getFloat(0.f, m_size.y) };
 		vertex.color = m_color;
-		vertex.color.a = static_cast<uint8_t>(randomAlpha());
+		vertex.color.a = static_cast<std::uint8_t>(1u + m_random.getInteger(254u));
 	}
 }
 
@@ -115,6 +91,11 @@ void Starfield::regenerate(const unsigned int numberOfStars)
 	regenerate(m_size, numberOfStars);
 }
 
+void Starfield::setSeed(const std::uint64_t seed)
+{
+	m_random.setSeed(seed);
+}
+
 void Starfield::setColor(const sf::Color color)
 {
 	m_color = color;
@@ -126,16 +107,28 @@ void Starfield::setColor(const sf::Color color)
 	}
 }
 
+void Starfield::appendVertices(VertexSink& sink, sf::RenderStates states) const
+{
+	states.transform *= getTransform();
+	const unsigned int size{ static_cast<unsigned int>(m_vertices.size()) };
+	if (size > 0)
+		sink.append(&m_vertices.front(), size, m_primitiveType, states);
+}
+
+void Starfield::appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform) const
+{
+	TriangleVertexSink sink{ vertices };
+	appendVertices(sink, sf::RenderStates{ transform });
+}
+
 
 
 // PRIVATE
 
 void Starfield::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	states.transform *= getTransform();
-	const unsigned int size{ static_cast<unsigned int>(m_vertices.size()) };
-	if (size > 0)
-		target.draw(&m_vertices.front(), size, m_primitiveType, states);
+	RenderTargetVertexSink sink{ target };
+	appendVertices(sink, states);
 }
 
 } // namespace selbaward
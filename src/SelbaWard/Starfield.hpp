@@ -34,6 +34,8 @@
 #define SELBAWARD_STARFIELD_HPP
 
 #include "Common.hpp"
+#include "VertexSink.hpp"
+#include "Random.hpp"
 
 namespace selbaward
 {
@@ -47,16 +49,22 @@ public:
 	void regenerate(sf::Vector2f size);
 	void regenerate(sf::Vector2f size, unsigned int numberOfStars);
 	void regenerate(unsigned int numberOfStars);
+	void setSeed(std::uint64_t seed); // reseeds the generator used by regenerate and move (call before regenerate for a reproducible field)
 
 	void setColor(sf::Color color);
 
 	void move(sf::Vector2f movement);
 
+	// vertex sink
+	void appendVertices(VertexSink& sink, sf::RenderStates states = sf::RenderStates::Default) const; // submits what would be drawn to a sink instead of a render target
+	void appendVertices(std::vector<sf::Vertex>& vertices, const sf::Transform& transform = sf::Transform::Identity) const; // appends what would be drawn as transformed triangles
+
 private:
 	sf::PrimitiveType m_primitiveType;
 	std::vector<sf::Vertex> m_vertices;
 	sf::Vector2f m_size;
 	sf::Color m_color;
+	Random m_random;
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 };
@@ -32,29 +32,11 @@
 
 #include "Starfield3d.hpp"
 
-#include <random>
-#include <functional>
 #include <cmath>
 
 namespace
 {
 
-std::mt19937 randomGenerator;
-std::uniform_int_distribution<unsigned short int> randomDistributionAlpha(1u, 255u);
-std::function <unsigned short int()> randomAlpha;
-
-inline void randomSeed()
-{
-	std::random_device rd;
-	randomGenerator.seed(rd());
-	randomAlpha = std::bind(randomDistributionAlpha, randomGenerator);
-}
-
-inline float randomValue(const float low, const float high)
-{
-	return std::uniform_real_distribution<float>{low, high}(randomGenerator);
-}
-
 template <class T>
 inline T linearTween(const T start, const T end, const float alpha)
 {
@@ -87,8 +69,8 @@ Starfield3d::Starfield3d(const sf::Vector2f size, const std::size_t numberOfStar
 	, m_backColor{ backColor }
 	, m_frontScale{ frontScale }
 	, m_backScale{ backScale }
+	, m_random()
 {
-	randomSeed();
 	regenerate();
 
 	m_starTemplate[0u].position = { 0.f, 1.f };
@@ -178,6 +160,11 @@ void Starfield3d::regenerate(const std::size_t numberOfStars)
 	regenerate(m_size, numberOfStars);
 }
 
+void Starfield3d::setSeed(const std::uint64_t seed)
+{
+	m_random.setSeed(seed);
+}
+
 void Starfield3d::setMaxDepth(const float maxDepth)
 {
 	m_isUpdateRequired = true;
@@ -295,9 +282,9 @@ sf::FloatRect Starfield3d::priv_calculateFrustumSliceBounds(float z) const
 sf::Vector3f Starfield3d::priv_generateRandomStarPosition() const
 {
 	sf::Vector3f position;
-	position.z = randomValue(0.f, m_maxDepth);
-	position.x = randomValue(m_deepestSliceBounds.position.x, m_deepestSliceBounds.position.x + m_deepestSliceBounds.size.x);
-	position.y = randomValue(m_deepestSliceBounds.position.y, m_deepestSliceBounds.position.y + m_deepestSliceBounds.size.y);
+	position.z = m_random.getFloat(0.f, m_maxDepth);
+	position.x = m_random.getFloat(m_deepestSliceBounds.position.x, m_deepestSliceBounds.position.x + m_deepestSliceBounds.size.x);
+	position.y = m_random.getFloat(m_deepestSliceBounds.position.y, m_deepestSliceBounds.position.y + m_deepestSliceBounds.size.y);
 	return position;
 }
 
@@ -310,21 +297,21 @@ sf::Vector3f Starfield3d::priv_generateRandomStarPosition(const EdgeLock edgeLoc
 	else if (edgeLock == EdgeLock::Back)
 		position.z = m_maxDepth;
 	else
-		position.z = randomValue(0.f, m_maxDepth);
+		position.z = m_random.getFloat(0.f, m_maxDepth);
 
 	if (edgeLock == EdgeLock::Left)
 		position.x = m_deepestSliceBounds.position.x;
 	else if (edgeLock == EdgeLock::Right)
 		position.x = m_deepestSliceBounds.position.x + m_deepestSliceBounds.size.x;
 	else
-		position.x = randomValue(m_deepestSliceBounds.position.x, m_deepestSliceBounds.position.x + m_deepestSliceBounds.size.x);
+		position.x = m_random.getFloat(m_deepestSliceBounds.position.x, m_deepestSliceBounds.position.x + m_deepestSliceBounds.size.x);
 
 	if (edgeLock == EdgeLock::Top)
 		position.y = m_deepestSliceBounds.position.y;
 	else if (edgeLock == EdgeLock::Bottom)
 		position.y = m_deepestSliceBounds.position.y + m_deepestSliceBounds.size.y;
 	else
-		position.y = randomValue(m_deepestSliceBounds.position.y, m_deepestSliceBounds.position.y + m_deepestSliceBounds.size.y);
+		position.y = m_random.getFloat(m_deepestSliceBounds.position.y, m_deepestSliceBounds.position.y + m_deepestSliceBounds.size.y);
 
 	return position;
 }
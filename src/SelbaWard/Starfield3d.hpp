@@ -34,6 +34,7 @@
 #define SELBAWARD_STARFIELD3D_HPP
 
 #include "Common.hpp"
+#include "Random.hpp"
 #include <SFML/System/Vector3.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 
@@ -49,6 +50,7 @@ public:
 	void regenerate(sf::Vector2f size);
 	void regenerate(sf::Vector2f size, std::size_t numberOfStars);
 	void regenerate(std::size_t numberOfStars);
+	void setSeed(std::uint64_t seed); // reseeds the generator used by regenerate and when stars wrap (call before regenerate for a reproducible field)
 
 	void setMaxDepth(float maxDepth);
 	void setFrontColor(const sf::Color& color);
@@ -82,6 +84,7 @@ private:
 	mutable std::vector<sf::Vertex> m_vertices;
 	mutable std::vector<std::size_t> m_positionIndices;
 	mutable sf::FloatRect m_deepestSliceBounds;
+	mutable Random m_random;
 
 	enum class EdgeLock
 	{
@@ -34,6 +34,7 @@
 #define SELBAWARD_TILEMAP_HPP
 
 #include "Common.hpp"
+#include "VertexBufferCache.hpp"
 
 #include <deque>
 #include <array>
@@ -77,6 +78,8 @@ public:
 	bool getSmooth() const;
 	void setSmoothScroll(bool smoothScroll);
 	bool getSmoothScroll() const;
+	void setUseVertexBuffer(bool useVertexBuffer, sf::VertexBuffer::Usage usage = sf::VertexBuffer::Usage::Static); // keeps the tile vertices on the GPU, re-uploading them only when the map is redrawn (vertices are drawn directly if vertex buffers are unavailable)
+	bool getUseVertexBuffer() const;
 	void setCameraTargetTile(sf::Vector2f cameraTargetTile);
 	sf::Vector2f getCameraTargetTile() const;
 	void setCamera(sf::Vector2f camera);
@@ -144,6 +147,7 @@ private:
 	sf::Vector2<std::size_t> m_textureOffset;
 	sf::Vector2<std::size_t> m_textureTileSize;
 	mutable std::vector<sf::Vertex> m_vertices;
+	mutable VertexBufferCache m_vertexBuffer;
 
 	// render
 	mutable bool m_redrawRequired;
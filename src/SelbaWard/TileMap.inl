@@ -56,6 +56,7 @@ TileMap<T>::TileMap()
 	, m_textureOffset{ 0u, 0u }
 	, m_textureTileSize{ 16u, 16u }
 	, m_vertices{}
+	, m_vertexBuffer{}
 	, m_redrawRequired{ true }
 	, m_renderTexture{}
 	, m_render(4u)
@@ -287,6 +288,18 @@ bool TileMap<T>::getSmoothScroll() const
 	return m_do.scrollSmoothly;
 }
 
+template <class T>
+void TileMap<T>::setUseVertexBuffer(const bool useVertexBuffer, const sf::VertexBuffer::Usage usage)
+{
+	m_vertexBuffer.setEnabled(useVertexBuffer, usage);
+}
+
+template <class T>
+bool TileMap<T>::getUseVertexBuffer() const
+{
+	return m_vertexBuffer.getEnabled();
+}
+
 template <class T>
 void TileMap<T>::setCameraTargetTile(const sf::Vector2f cameraTileTarget)
 {
@@ -390,6 +403,7 @@ template <class T>
 void TileMap<T>::priv_updateVertices() const
 {
 	m_vertices.resize(static_cast<std::size_t>(m_gridSize.x) * m_gridSize.y * 6u);
+	m_vertexBuffer.invalidate(); // every vertex depends on the camera offset
 	if (m_gridSize.x == 0u || m_gridSize.y == 0u)
 		return;
 
@@ -461,9 +475,7 @@ void TileMap<T>::priv_updateRender() const
 	}
 
 	m_renderTexture.clear(sf::Color::Transparent);
-	const std::size_t numberOfVertices{ m_vertices.size() };
-	if (numberOfVertices > 0u)
-		m_renderTexture.draw(m_vertices.data(), numberOfVertices, sf::PrimitiveType::Triangles, m_texture);
+	m_vertexBuffer.draw(m_renderTexture, m_vertices, sf::PrimitiveType::Triangles, m_texture);
 	m_renderTexture.display();
 
 	m_renderTexture.setSmooth(m_is.smooth);
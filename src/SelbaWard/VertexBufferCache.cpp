@@ -0,0 +1,149 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Selba Ward (https://github.com/Hapaxia/SelbaWard)
+// --
+//
+// Vertex Buffer Cache
+//
+// Copyright(c) 2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "VertexBufferCache.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+
+constexpr std::size_t allVertices{ std::numeric_limits<std::size_t>::max() };
+
+} // namespace
+
+namespace selbaward
+{
+
+VertexBufferCache::VertexBufferCache()
+	: m_buffer(sf::VertexBuffer::Usage::Static)
+	, m_isEnabled{ false }
+	, m_changedBegin{ 0u }
+	, m_changedEnd{ allVertices }
+{
+}
+
+VertexBufferCache::VertexBufferCache(const VertexBufferCache& other)
+	: m_buffer(other.m_buffer.getUsage())
+	, m_isEnabled{ other.m_isEnabled }
+	, m_changedBegin{ 0u }
+	, m_changedEnd{ allVertices }
+{
+}
+
+VertexBufferCache& VertexBufferCache::operator=(const VertexBufferCache& other)
+{
+	setEnabled(other.m_isEnabled, other.m_buffer.getUsage());
+	invalidate();
+
+	return *this;
+}
+
+void VertexBufferCache::setEnabled(const bool enabled, const sf::VertexBuffer::Usage usage)
+{
+	if (enabled && !m_isEnabled)
+		invalidate();
+	m_isEnabled = enabled;
+	m_buffer.setUsage(usage);
+}
+
+void VertexBufferCache::invalidate()
+{
+	m_changedBegin = 0u;
+	m_changedEnd = allVertices;
+}
+
+void VertexBufferCache::invalidate(const std::size_t firstVertex, const std::size_t numberOfVertices)
+{
+	if (numberOfVertices == 0u)
+		return;
+
+	// changes are merged into a single range so that they can be uploaded together
+	if (m_changedBegin >= m_changedEnd)
+	{
+		m_changedBegin = firstVertex;
+		m_changedEnd = firstVertex + numberOfVertices;
+	}
+	else
+	{
+		m_changedBegin = std::min(m_changedBegin, firstVertex);
+		m_changedEnd = std::max(m_changedEnd, firstVertex + numberOfVertices);
+	}
+}
+
+void VertexBufferCache::draw(sf::RenderTarget& target, const std::vector<sf::Vertex>& vertices, const sf::PrimitiveType primitiveType, const sf::RenderStates& states)
+{
+	draw(target, vertices, 0u, vertices.size(), primitiveType, states);
+}
+
+void VertexBufferCache::draw(sf::RenderTarget& target, const std::vector<sf::Vertex>& vertices, const std::size_t firstVertex, const std::size_t numberOfVertices, const sf::PrimitiveType primitiveType, const sf::RenderStates& states)
+{
+	if (numberOfVertices == 0u)
+		return;
+
+	if (priv_upload(vertices, primitiveType))
+		target.draw(m_buffer, firstVertex, numberOfVertices, states);
+	else
+		target.draw(vertices.data() + firstVertex, numberOfVertices, primitiveType, states);
+}
+
+
+
+// PRIVATE
+
+bool VertexBufferCache::priv_upload(const std::vector<sf::Vertex>& vertices, const sf::PrimitiveType primitiveType)
+{
+	if (!isActive())
+		return false;
+
+	m_buffer.setPrimitiveType(primitiveType);
+	if (m_buffer.getVertexCount() != vertices.size())
+	{
+		if (!m_buffer.create(vertices.size()))
+			return false;
+		invalidate();
+	}
+
+	const std::size_t changedEnd{ std::min(m_changedEnd, vertices.size()) };
+	if (m_changedBegin < changedEnd)
+	{
+		if (!m_buffer.update(vertices.data() + m_changedBegin, changedEnd - m_changedBegin, static_cast<unsigned int>(m_changedBegin)))
+			return false;
+	}
+	m_changedBegin = 0u;
+	m_changedEnd = 0u;
+
+	return true;
+}
+
+} // namespace selbaward
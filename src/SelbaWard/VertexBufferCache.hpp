@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Selba Ward (https://github.com/Hapaxia/SelbaWard)
+// --
+//
+// Vertex Buffer Cache
+//
+// Copyright(c) 2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef SELBAWARD_VERTEXBUFFERCACHE_HPP
+#define SELBAWARD_VERTEXBUFFERCACHE_HPP
+
+#include "Common.hpp"
+
+#include <SFML/Graphics/VertexBuffer.hpp>
+
+namespace selbaward
+{
+
+// SW Vertex Buffer Cache v1.0.0
+// optional GPU-resident copy of a drawable's vertices; only ranges marked as changed are uploaded when drawn.
+// when disabled or when vertex buffers are unavailable, the vertices are drawn directly from the vector instead
+class VertexBufferCache
+{
+public:
+	VertexBufferCache();
+	VertexBufferCache(const VertexBufferCache& other); // copies the settings only; the copy uploads all vertices when it is first drawn
+	VertexBufferCache& operator=(const VertexBufferCache& other);
+	void setEnabled(bool enabled, sf::VertexBuffer::Usage usage = sf::VertexBuffer::Usage::Static);
+	bool getEnabled() const;
+	sf::VertexBuffer::Usage getUsage() const;
+	bool isActive() const; // enabled and vertex buffers are available
+	void invalidate(); // all vertices have changed (a change in the number of vertices is always detected)
+	void invalidate(std::size_t firstVertex, std::size_t numberOfVertices);
+	void draw(sf::RenderTarget& target, const std::vector<sf::Vertex>& vertices, sf::PrimitiveType primitiveType, const sf::RenderStates& states);
+	void draw(sf::RenderTarget& target, const std::vector<sf::Vertex>& vertices, std::size_t firstVertex, std::size_t numberOfVertices, sf::PrimitiveType primitiveType, const sf::RenderStates& states);
+
+private:
+	sf::VertexBuffer m_buffer;
+	bool m_isEnabled;
+	std::size_t m_changedBegin;
+	std::size_t m_changedEnd;
+
+	bool priv_upload(const std::vector<sf::Vertex>& vertices, sf::PrimitiveType primitiveType);
+};
+
+inline bool VertexBufferCache::getEnabled() const
+{
+	return m_isEnabled;
+}
+
+inline sf::VertexBuffer::Usage VertexBufferCache::getUsage() const
+{
+	return m_buffer.getUsage();
+}
+
+inline bool VertexBufferCache::isActive() const
+{
+	return m_isEnabled && sf::VertexBuffer::isAvailable();
+}
+
+} // namespace selbaward
+#endif // SELBAWARD_VERTEXBUFFERCACHE_HPP
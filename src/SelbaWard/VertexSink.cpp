@@ -0,0 +1,161 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Selba Ward (https://github.com/Hapaxia/SelbaWard)
+// --
+//
+// Vertex Sink
+//
+// Copyright(c) 2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "VertexSink.hpp"
+
+#include <cmath>
+
+namespace
+{
+
+constexpr float lineThickness{ 1.f }; // thickness of the quads that represent lines
+constexpr float pointSize{ 1.f }; // size of the squares that represent points
+
+std::size_t maximumNumberOfTriangleVertices(const std::size_t numberOfVertices, const sf::PrimitiveType primitiveType)
+{
+	switch (primitiveType)
+	{
+	case sf::PrimitiveType::Triangles:
+		return numberOfVertices - numberOfVertices % 3u;
+	case sf::PrimitiveType::TriangleStrip:
+	case sf::PrimitiveType::TriangleFan:
+		return (numberOfVertices > 2u) ? (numberOfVertices - 2u) * 3u : 0u;
+	case sf::PrimitiveType::Points:
+		return numberOfVertices * 6u;
+	case sf::PrimitiveType::Lines:
+		return numberOfVertices / 2u * 6u;
+	case sf::PrimitiveType::LineStrip:
+		return (numberOfVertices > 1u) ? (numberOfVertices - 1u) * 6u : 0u;
+	}
+	return 0u;
+}
+
+} // namespace
+
+namespace selbaward
+{
+
+RenderTargetVertexSink::RenderTargetVertexSink(sf::RenderTarget& target)
+	: m_target(target)
+{
+}
+
+void RenderTargetVertexSink::append(const sf::Vertex* const vertices, const std::size_t numberOfVertices, const sf::PrimitiveType primitiveType, const sf::RenderStates& states)
+{
+	m_target.draw(vertices, numberOfVertices, primitiveType, states);
+}
+
+TriangleVertexSink::TriangleVertexSink(std::vector<sf::Vertex>& vertices)
+	: m_vertices(vertices)
+{
+}
+
+void TriangleVertexSink::append(const sf::Vertex* const vertices, const std::size_t numberOfVertices, const sf::PrimitiveType primitiveType, const sf::RenderStates& states)
+{
+	appendTriangles(m_vertices, vertices, numberOfVertices, primitiveType, states.transform);
+}
+
+void TriangleVertexSink::appendTriangles(std::vector<sf::Vertex>& destination, const sf::Vertex* const vertices, const std::size_t numberOfVertices, const sf::PrimitiveType primitiveType, const sf::Transform& transform)
+{
+	// the destination is grown once to the largest possible size and then trimmed (only degenerate lines produce fewer vertices)
+	const std::size_t initialSize{ destination.size() };
+	destination.resize(initialSize + maximumNumberOfTriangleVertices(numberOfVertices, primitiveType));
+	sf::Vertex* output{ destination.data() + initialSize };
+
+	const auto add = [&](const sf::Vertex& vertex, const sf::Vector2f offset = { 0.f, 0.f })
+	{
+		*output = vertex;
+		output->position = transform.transformPoint(vertex.position + offset);
+		++output;
+	};
+	const auto addLine = [&](const sf::Vertex& start, const sf::Vertex& end)
+	{
+		const sf::Vector2f direction{ end.position - start.position };
+		const float length{ std::sqrt(direction.x * direction.x + direction.y * direction.y) };
+		if (length == 0.f)
+			return;
+		const sf::Vector2f offset{ -direction.y / length * lineThickness * 0.5f, direction.x / length * lineThickness * 0.5f };
+		add(start, offset);
+		add(start, -offset);
+		add(end, offset);
+		add(end, offset);
+		add(start, -offset);
+		add(end, -offset);
+	};
+
+	switch (primitiveType)
+	{
+	case sf::PrimitiveType::Triangles:
+		for (std::size_t i{ 0u }; i < (numberOfVertices - numberOfVertices % 3u); ++i)
+			add(vertices[i]);
+		break;
+	case sf::PrimitiveType::TriangleStrip:
+		for (std::size_t i{ 2u }; i < numberOfVertices; ++i)
+		{
+			add(vertices[i - 2u]);
+			add(vertices[i - 1u]);
+			add(vertices[i]);
+		}
+		break;
+	case sf::PrimitiveType::TriangleFan:
+		for (std::size_t i{ 2u }; i < numberOfVertices; ++i)
+		{
+			add(vertices[0u]);
+			add(vertices[i - 1u]);
+			add(vertices[i]);
+		}
+		break;
+	case sf::PrimitiveType::Points:
+		for (std::size_t i{ 0u }; i < numberOfVertices; ++i)
+		{
+			add(vertices[i]);
+			add(vertices[i], { 0.f, pointSize });
+			add(vertices[i], { pointSize, 0.f });
+			add(vertices[i], { pointSize, 0.f });
+			add(vertices[i], { 0.f, pointSize });
+			add(vertices[i], { pointSize, pointSize });
+		}
+		break;
+	case sf::PrimitiveType::Lines:
+		for (std::size_t i{ 1u }; i < numberOfVertices; i += 2u)
+			addLine(vertices[i - 1u], vertices[i]);
+		break;
+	case sf::PrimitiveType::LineStrip:
+		for (std::size_t i{ 1u }; i < numberOfVertices; ++i)
+			addLine(vertices[i - 1u], vertices[i]);
+		break;
+	}
+
+	destination.resize(static_cast<std::size_t>(output - destination.data()));
+}
+
+} // namespace selbaward
@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// Selba Ward (https://github.com/Hapaxia/SelbaWard)
+// --
+//
+// Vertex Sink
+//
+// Copyright(c) 2026 M.J.Silk
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions :
+//
+// 1. The origin of this software must not be misrepresented; you must not
+// claim that you wrote the original software.If you use this software
+// in a product, an acknowledgment in the product documentation would be
+// appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+// misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+// M.J.Silk
+// MJSilk2@gmail.com
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef SELBAWARD_VERTEXSINK_HPP
+#define SELBAWARD_VERTEXSINK_HPP
+
+#include "Common.hpp"
+
+#include <SFML/Graphics/PrimitiveType.hpp>
+
+namespace selbaward
+{
+
+// SW Vertex Sink v1.0.0
+// receives the geometry that a drawable would draw (see each drawable's appendVertices)
+class VertexSink
+{
+public:
+	virtual ~VertexSink() = default;
+	virtual void append(const sf::Vertex* vertices, std::size_t numberOfVertices, sf::PrimitiveType primitiveType, const sf::RenderStates& states) = 0;
+};
+
+// draws each append to a render target
+class RenderTargetVertexSink : public VertexSink
+{
+public:
+	explicit RenderTargetVertexSink(sf::RenderTarget& target);
+	void append(const sf::Vertex* vertices, std::size_t numberOfVertices, sf::PrimitiveType primitiveType, const sf::RenderStates& states) override;
+
+private:
+	sf::RenderTarget& m_target;
+};
+
+// appends to a caller-owned vector as a list of triangles (sf::PrimitiveType::Triangles) with the states' transform applied. other states (e.g. texture) are ignored
+class TriangleVertexSink : public VertexSink
+{
+public:
+	explicit TriangleVertexSink(std::vector<sf::Vertex>& vertices);
+	void append(const sf::Vertex* vertices, std::size_t numberOfVertices, sf::PrimitiveType primitiveType, const sf::RenderStates& states) override;
+
+	// points become one-unit squares and lines become one-unit wide quads
+	static void appendTriangles(std::vector<sf::Vertex>& destination, const sf::Vertex* vertices, std::size_t numberOfVertices, sf::PrimitiveType primitiveType, const sf::Transform& transform);
+
+private:
+	std::vector<sf::Vertex>& m_vertices;
+};
+
+} // namespace selbaward
+#endif // SELBAWARD_VERTEXSINK_HPP